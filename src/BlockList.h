@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+// BlockList.h
+// ===========
+// append-only list built from fixed-size blocks with a block index
+// The elements are stored in blocks of N elements, and the block index (a
+// list of block pointers) gives random access: element i is at
+// blocks[(first + i) / N][(first + i) % N].
+//
+// Adding an element at the end allocates a new block when the last one is
+// full, but never moves or copies the existing elements, so references and
+// pointers to the elements stay valid until the element itself is removed.
+// Removing from the front (or the back) is O(1); an empty block is kept as a
+// spare for the next growth, so a sliding window does not allocate memory in
+// the steady state.
+//
+// NOTE: The element type must be default constructible; a block constructs
+// all of its N elements when allocated, and a removed element is reset to
+// E() to release its resources.
+//
+// Dependencies: none
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BLOCK_LIST_H_DEF
+#define BLOCK_LIST_H_DEF
+
+#include <vector>
+#include <stdexcept>
+
+template<typename E, int N = 64>
+class BlockList
+{
+public:
+    // ctor/dtor
+    BlockList() : spare(0), firstBlock(0), first(0), count(0) {}
+    BlockList(const BlockList& rhs) : spare(0), firstBlock(0), first(0), count(0) { copy(rhs); }
+    ~BlockList()                                        { clear(); delete [] spare; }
+    BlockList& operator=(const BlockList& rhs)          { if(this != &rhs) { clear(); copy(rhs); } return *this; }
+
+    int size() const                                    { return count; }
+    bool empty() const                                  { return count == 0; }
+    int getBlockCount() const                           { return (int)blocks.size() - firstBlock; }
+    static int getBlockSize()                           { return N; }
+
+    // element access
+    E& operator[](int index)                            { int k = first + index; return blocks[firstBlock + k / N][k % N]; }
+    const E& operator[](int index) const                { int k = first + index; return blocks[firstBlock + k / N][k % N]; }
+    E& at(int index)                                    { check(index); return (*this)[index]; }
+    const E& at(int index) const                        { check(index); return (*this)[index]; }
+    E& front()                                          { return (*this)[0]; }
+    const E& front() const                              { return (*this)[0]; }
+    E& back()                                           { return (*this)[count - 1]; }
+    const E& back() const                               { return (*this)[count - 1]; }
+
+    // modifiers
+    void push_back(const E& value);
+    void pop_back();
+    void pop_front();
+    void resize(int size, const E& value = E());
+    void clear();
+    template<typename Iterator>
+    void assign(Iterator begin, Iterator end)           { clear(); for(; begin != end; ++begin) push_back(*begin); }
+
+private:
+    void check(int index) const                         { if(index < 0 || index >= count) throw std::out_of_range("BlockList"); }
+    void copy(const BlockList& rhs)                     { for(int i = 0; i < rhs.count; ++i) push_back(rhs[i]); }
+    E* allocateBlock();
+    void releaseBlock(E* block);
+
+    std::vector<E*> blocks;     // block index, the used blocks start at firstBlock
+    E* spare;                   // empty block to reuse
+    int firstBlock;             // index of the first used block
+    int first;                  // position of the first element in the first block
+    int count;                  // number of elements
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add an element at the end
+///////////////////////////////////////////////////////////////////////////////
+template<typename E, int N>
+void BlockList<E, N>::push_back(const E& value)
+{
+    int k = first + count;
+    if(firstBlock + k / N == (int)blocks.size())
+    {
+        // drop the unused slots of the block index before it grows
+        if(firstBlock > 0 && firstBlock * 2 >= (int)blocks.size())
+        {
+            blocks.erase(blocks.begin(), blocks.begin() + firstBlock);
+            firstBlock = 0;
+        }
+        blocks.push_back(allocateBlock());
+    }
+    blocks[firstBlock + k / N][k % N] = value;
+    ++count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove the last element
+///////////////////////////////////////////////////////////////////////////////
+template<typename E, int N>
+void BlockList<E, N>::pop_back()
+{
+    if(count == 0)
+        return;
+
+    back() = E();
+    --count;
+
+    // release the last block if it became empty
+    int k = first + count;
+    if(k % N == 0 || count == 0)
+    {
+        releaseBlock(blocks.back());
+        blocks.pop_back();
+        if(count == 0)
+        {
+            blocks.clear();
+            firstBlock = first = 0;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove the first element
+///////////////////////////////////////////////////////////////////////////////
+template<typename E, int N>
+void BlockList<E, N>::pop_front()
+{
+    if(count == 0)
+        return;
+
+    front() = E();
+    --count;
+    ++first;
+
+    // release the first block if it became empty
+    if(first == N || count == 0)
+    {
+        releaseBlock(blocks[firstBlock]);
+        blocks[firstBlock] = 0;
+        ++firstBlock;
+        first = 0;
+        if(count == 0)
+        {
+            blocks.clear();
+            firstBlock = 0;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// resize the list, new elements are copies of value
+///////////////////////////////////////////////////////////////////////////////
+template<typename E, int N>
+void BlockList<E, N>::resize(int size, const E& value)
+{
+    if(size < 0)
+        size = 0;
+    while(count > size)
+        pop_back();
+    while(count < size)
+        push_back(value);
+}
+
+template<typename E, int N>
+void BlockList<E, N>::clear()
+{
+    for(int i = firstBlock; i < (int)blocks.size(); ++i)
+        delete [] blocks[i];
+    blocks.clear();
+    firstBlock = first = count = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take the spare block or allocate a new one
+///////////////////////////////////////////////////////////////////////////////
+template<typename E, int N>
+E* BlockList<E, N>::allocateBlock()
+{
+    E* block = spare;
+    spare = 0;
+    if(!block)
+        block = new E[N];
+    return block;
+}
+
+// keep one empty block as spare, delete the others
+template<typename E, int N>
+void BlockList<E, N>::releaseBlock(E* block)
+{
+    if(spare)
+        delete [] block;
+    else
+        spare = block;
+}
+
+#endif
@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// ImplicitPipe.cpp
+// ================
+// compact pipe storing only a frame per ring and the shared base contour
+//
+// Dependencies: Vector3, Matrix4, Quaternion, Pipe, Kernels
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ImplicitPipe.h"
+#include "Kernels.h"
+#include "Matrices.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctors
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+ImplicitPipeT<T>::ImplicitPipeT(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints)
+{
+    set(pathPoints, contourPoints);
+}
+
+template<typename T>
+ImplicitPipeT<T>::ImplicitPipeT(const PipeT<T>& pipe)
+{
+    set(pipe);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// setters
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void ImplicitPipeT<T>::set(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints)
+{
+    this->contour = contourPoints;
+
+    int count = (int)pathPoints.size();
+    rings.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        rings[i].center = pathPoints[i];
+        rings[i].scale = 1;
+    }
+
+    // propagate the frame along the path
+    for(int i = 0; i < count; ++i)
+        rings[i].rotation = computeFrame(i);
+}
+
+template<typename T>
+void ImplicitPipeT<T>::set(const PipeT<T>& pipe)
+{
+    if(pipe.getSweep() != PIPE_SWEEP_FRAME)
+    {
+        std::vector< Vector3T<T> > pathPoints(pipe.getPathCount());
+        for(int i = 0; i < (int)pathPoints.size(); ++i)
+            pathPoints[i] = pipe.getPathPoint(i);
+        set(pathPoints, pipe.getBaseContour());
+        return;
+    }
+
+    // copy the frames as they are (the pending frames after edit are old)
+    this->contour = pipe.getBaseContour();
+    int count = pipe.getPathCount();
+    rings.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        rings[i].center = pipe.getPathPoint(i);
+        rings[i].rotation = pipe.getFrame(i);
+        rings[i].scale = 1;
+    }
+}
+
+template<typename T>
+void ImplicitPipeT<T>::setContour(const std::vector< Vector3T<T> >& contourPoints)
+{
+    // the frames do not depend on the contour
+    this->contour = contourPoints;
+}
+
+template<typename T>
+void ImplicitPipeT<T>::setScale(int index, T scale)
+{
+    rings.at(index).scale = scale;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a new path point at the end
+// The new point changes the tangent at the previous point, so the frames of
+// the last 2 rings are updated.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void ImplicitPipeT<T>::addPathPoint(const Vector3T<T>& point)
+{
+    RingFrameT<T> ring;
+    ring.center = point;
+    ring.scale = 1;
+    rings.push_back(ring);
+
+    int count = (int)rings.size();
+    int first = (count > 1) ? count - 2 : 0;
+    for(int i = first; i < count; ++i)
+        rings[i].rotation = computeFrame(i);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// expand the vertices (and normals) of a ring to the buffers
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void ImplicitPipeT<T>::expandContour(int index, Vector3T<T>* vertices, Vector3T<T>* normals) const
+{
+    int vertexCount = (int)contour.size();
+    if(vertexCount == 0)
+        return;
+
+    const RingFrameT<T>& ring = rings[index];
+    Matrix4T<T> matrix = ring.rotation.getMatrix();
+    if(ring.scale != 1)
+        matrix.scale(ring.scale);
+    matrix.translate(ring.center);
+
+    const KernelTable<T>& kernels = getKernels<T>();
+    kernels.transformPoints(matrix.get(), &contour[0], vertexCount, vertices);
+    if(normals)
+        kernels.computeRingNormals(vertices, vertexCount, ring.center, normals);
+}
+
+// expand count rings from first to the buffers continuously
+// return the number of expanded rings
+template<typename T>
+int ImplicitPipeT<T>::expandContours(int first, int count, Vector3T<T>* vertices, Vector3T<T>* normals) const
+{
+    int ringCount = (int)rings.size();
+    if(first < 0)
+        first = 0;
+    if(first + count > ringCount)
+        count = ringCount - first;
+
+    int vertexCount = (int)contour.size();
+    for(int i = 0; i < count; ++i)
+    {
+        expandContour(first + i, vertices + i * vertexCount,
+                      normals ? normals + i * vertexCount : 0);
+    }
+    return (count > 0) ? count : 0;
+}
+
+template<typename T>
+typename ImplicitPipeT<T>::ContourIterator ImplicitPipeT<T>::getContourIterator(int first, int count) const
+{
+    return ContourIterator(*this, first, count);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// same as PipeT::computeTangent() and PipeT::computeFrame() with the ring
+// centers as the path
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+Vector3T<T> ImplicitPipeT<T>::computeTangent(int index) const
+{
+    int count = (int)rings.size();
+    if(count < 2)
+        return Vector3T<T>(0, 0, 1);    // no direction, same as the contour
+
+    Vector3T<T> dir1, dir2;
+    if(index == 0)
+        dir1 = rings[1].center - rings[0].center;
+    else
+        dir1 = rings[index].center - rings[index - 1].center;
+
+    if(index == count - 1)
+        dir2 = dir1;
+    else
+        dir2 = rings[index + 1].center - rings[index].center;
+
+    return getPipeTangent(dir1, dir2);
+}
+
+template<typename T>
+QuaternionT<T> ImplicitPipeT<T>::computeFrame(int index) const
+{
+    if(index == 0)
+    {
+        if(rings.size() < 2)
+            return QuaternionT<T>();    // identity
+
+        return getPipeFirstFrame(rings[1].center - rings[0].center);
+    }
+
+    return getPipeNextFrame(rings[index - 1].rotation, computeTangent(index - 1), computeTangent(index));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ContourIterator
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+ImplicitPipeT<T>::ContourIterator::ContourIterator(const ImplicitPipeT& pipe, int first, int count)
+: pipe(&pipe), index(first - 1), last(first + count - 1)
+{
+    int ringCount = pipe.getRingCount();
+    if(count < 0 || last >= ringCount)
+        last = ringCount - 1;
+}
+
+template<typename T>
+bool ImplicitPipeT<T>::ContourIterator::next()
+{
+    if(index >= last)
+        return false;
+
+    ++index;
+    if(index < 0)
+        index = 0;
+
+    int vertexCount = pipe->getVertexCount();
+    vertices.resize(vertexCount);
+    normals.resize(vertexCount);
+    if(vertexCount > 0)
+        pipe->expandContour(index, &vertices[0], &normals[0]);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+///////////////////////////////////////////////////////////////////////////////
+template class ImplicitPipeT<float>;
+template class ImplicitPipeT<double>;
@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// ImplicitPipe.h
+// ==============
+// compact pipe storing only a frame per ring and the shared base contour
+// With the frame-based sweep (PIPE_SWEEP_FRAME of Pipe), each ring is fully
+// determined by its center, rotation and scale. So the ring vertices and
+// normals are not stored; they are expanded on demand into caller buffers or
+// one ring at a time with ContourIterator, which can feed a renderer or an
+// exporter directly.
+//
+// A ring costs 32 bytes (float) regardless of the contour size, where Pipe
+// stores 24 bytes per vertex for the contour and normals, e.g. 33 vertices
+// per ring take 792 bytes.
+//
+// The frames are propagated the same way as PIPE_SWEEP_FRAME, and the
+// expanded contours are same as the ones of Pipe if the scale is 1.
+//
+// Dependencies: Vector3, Matrix4, Quaternion, Pipe, Kernels
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef IMPLICIT_PIPE_H_DEF
+#define IMPLICIT_PIPE_H_DEF
+
+#include <vector>
+#include "Vectors.h"
+#include "Quaternion.h"
+#include "Pipe.h"
+
+// placement of the base contour at a path point
+template<typename T>
+struct RingFrameT
+{
+    Vector3T<T> center;         // path point
+    QuaternionT<T> rotation;    // frame of the ring
+    T scale;                    // uniform scale of the base contour
+};
+
+template<typename T>
+class ImplicitPipeT
+{
+public:
+    // expand rings one by one into its own buffer
+    // for(ImplicitPipe::ContourIterator it = pipe.getContourIterator(); it.next(); )
+    //     draw(it.getVertices(), it.getNormals(), it.getCount());
+    class ContourIterator
+    {
+    public:
+        ContourIterator(const ImplicitPipeT& pipe, int first, int count);
+        bool next();                                    // expand next ring, false at the end
+        int getIndex() const                            { return index; }
+        int getCount() const                            { return (int)vertices.size(); }
+        const Vector3T<T>* getVertices() const          { return vertices.empty() ? 0 : &vertices[0]; }
+        const Vector3T<T>* getNormals() const           { return normals.empty() ? 0 : &normals[0]; }
+
+    private:
+        const ImplicitPipeT* pipe;
+        int index;                                      // current ring
+        int last;                                       // index of the last ring
+        std::vector< Vector3T<T> > vertices;
+        std::vector< Vector3T<T> > normals;
+    };
+
+    // ctor/dtor
+    ImplicitPipeT() {}
+    ImplicitPipeT(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints);
+    explicit ImplicitPipeT(const PipeT<T>& pipe);
+    ~ImplicitPipeT() {}
+
+    // setters/getters
+    void set(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints);
+    void set(const PipeT<T>& pipe);             // keep the frames of PIPE_SWEEP_FRAME pipe
+    void setContour(const std::vector< Vector3T<T> >& contourPoints);
+    void addPathPoint(const Vector3T<T>& point);
+    void setScale(int index, T scale);
+
+    int getRingCount() const                                        { return (int)rings.size(); }
+    int getVertexCount() const                                      { return (int)contour.size(); } // per ring
+    const RingFrameT<T>& getRing(int index) const                   { return rings.at(index); }
+    const std::vector< Vector3T<T> >& getBaseContour() const        { return contour; }
+
+    // expand rings to the caller buffers, getVertexCount() vertices per ring
+    // normals can be NULL to expand the vertices only
+    void expandContour(int index, Vector3T<T>* vertices, Vector3T<T>* normals) const;
+    int expandContours(int first, int count, Vector3T<T>* vertices, Vector3T<T>* normals) const;
+    ContourIterator getContourIterator(int first=0, int count=-1) const;
+
+protected:
+
+private:
+    Vector3T<T> computeTangent(int index) const;
+    QuaternionT<T> computeFrame(int index) const;
+
+    std::vector< Vector3T<T> > contour;         // base contour shared by all rings
+    std::vector< RingFrameT<T> > rings;
+};
+
+// aliases for single and double precision
+typedef RingFrameT<float>     RingFrame;
+typedef RingFrameT<double>    RingFramed;
+typedef ImplicitPipeT<float>  ImplicitPipe;
+typedef ImplicitPipeT<double> ImplicitPiped;
+
+#endif
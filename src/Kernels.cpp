@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////
+// Kernels.cpp
+// ===========
+// hot geometry kernels of the pipe generator with runtime CPU dispatch
+// This file builds the baseline kernels (SSE2 on x86-64) and selects the
+// best kernel table for the running CPU.
+//
+// Dependencies: Kernels, KernelsImpl
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Kernels.h"
+
+#if KERNELS_X86
+#include <cpuid.h>
+#endif
+
+// the kernel loops need the dynamic cost model to be vectorized at -O2
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("tree-vectorize", "vect-cost-model=dynamic")
+#endif
+
+namespace
+{
+#include "KernelsImpl.h"
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+#if KERNELS_X86
+#define KERNELS_GENERIC_NAME "sse2"
+#else
+#define KERNELS_GENERIC_NAME "generic"
+#endif
+
+static const KernelTable<float> kernelsGenericf =
+{
+    KERNELS_GENERIC_NAME,
+    projectRing<float>,
+    computeRingNormals<float>,
+    transformPoints<float>,
+    buildStrip<float>,
+    intersectLinesPlane<float>,
+    intersectLinesPlanes<float>,
+    intersectRaysPlane<float>,
+    intersectLinesLines<float>,
+    testSpheresPlanes<float>
+};
+
+static const KernelTable<double> kernelsGenericd =
+{
+    KERNELS_GENERIC_NAME,
+    projectRing<double>,
+    computeRingNormals<double>,
+    transformPoints<double>,
+    buildStrip<double>,
+    intersectLinesPlane<double>,
+    intersectLinesPlanes<double>,
+    intersectRaysPlane<double>,
+    intersectLinesLines<double>,
+    testSpheresPlanes<double>
+};
+
+#if KERNELS_X86
+extern const KernelTable<float> kernelsAVX2f;
+extern const KernelTable<double> kernelsAVX2d;
+extern const KernelTable<float> kernelsAVX512f;
+extern const KernelTable<double> kernelsAVX512d;
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the highest ISA supported by both CPU and OS
+// AVX needs the OS to save YMM (and ZMM/opmask for AVX-512) state on context
+// switch, so XCR0 is checked as well as the cpuid feature bits.
+///////////////////////////////////////////////////////////////////////////////
+KernelIsa detectKernelIsa()
+{
+#if KERNELS_X86
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return KERNEL_ISA_GENERIC;
+
+    bool osxsave = (ecx & (1u << 27)) != 0;
+    bool avx     = (ecx & (1u << 28)) != 0;
+    bool fma     = (ecx & (1u << 12)) != 0;
+    if(!osxsave || !avx || !fma)
+        return KERNEL_ISA_GENERIC;
+
+    // read XCR0 with xgetbv
+    unsigned int xcr0Lo, xcr0Hi;
+    __asm__ __volatile__("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+    if((xcr0Lo & 0x6) != 0x6)                   // XMM and YMM state
+        return KERNEL_ISA_GENERIC;
+
+    if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return KERNEL_ISA_GENERIC;
+
+    bool avx2     = (ebx & (1u << 5)) != 0;
+    bool avx512f  = (ebx & (1u << 16)) != 0;
+    bool avx512vl = (ebx & (1u << 31)) != 0;
+    if(!avx2)
+        return KERNEL_ISA_GENERIC;
+
+    if(avx512f && avx512vl && (xcr0Lo & 0xe0) == 0xe0)  // opmask, ZMM state
+        return KERNEL_ISA_AVX512;
+
+    return KERNEL_ISA_AVX2;
+#else
+    return KERNEL_ISA_GENERIC;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// select the kernel ISA once
+// PIPE_KERNEL_ISA can lower (never raise) the detected ISA for testing
+///////////////////////////////////////////////////////////////////////////////
+static KernelIsa selectKernelIsa()
+{
+    KernelIsa isa = detectKernelIsa();
+
+    const char* env = getenv("PIPE_KERNEL_ISA");
+    if(env && *env)
+    {
+        KernelIsa requested;
+        if(strcmp(env, "sse2") == 0 || strcmp(env, "generic") == 0)
+            requested = KERNEL_ISA_GENERIC;
+        else if(strcmp(env, "avx2") == 0)
+            requested = KERNEL_ISA_AVX2;
+        else if(strcmp(env, "avx512") == 0)
+            requested = KERNEL_ISA_AVX512;
+        else
+        {
+            std::cerr << "[WARNING] Unknown PIPE_KERNEL_ISA: " << env << std::endl;
+            return isa;
+        }
+
+        if(requested > isa)
+            std::cerr << "[WARNING] PIPE_KERNEL_ISA=" << env
+                      << " is not supported by this CPU." << std::endl;
+        else
+            isa = requested;
+    }
+    return isa;
+}
+
+
+
+KernelIsa getKernelIsa()
+{
+    static const KernelIsa isa = selectKernelIsa();
+    return isa;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pick the float or double table of the selected ISA
+///////////////////////////////////////////////////////////////////////////////
+#if KERNELS_X86
+template<typename T>
+static const KernelTable<T>& selectKernels(const KernelTable<T>& generic,
+                                           const KernelTable<T>& avx2,
+                                           const KernelTable<T>& avx512)
+{
+    switch(getKernelIsa())
+    {
+    case KERNEL_ISA_AVX512:
+        return avx512;
+    case KERNEL_ISA_AVX2:
+        return avx2;
+    default:
+        return generic;
+    }
+}
+#else
+template<typename T>
+static const KernelTable<T>& selectKernels(const KernelTable<T>& generic)
+{
+    return generic;
+}
+#endif
+
+
+
+template<>
+const KernelTable<float>& getKernels<float>()
+{
+#if KERNELS_X86
+    static const KernelTable<float>& table = selectKernels(kernelsGenericf, kernelsAVX2f, kernelsAVX512f);
+#else
+    static const KernelTable<float>& table = selectKernels(kernelsGenericf);
+#endif
+    return table;
+}
+
+
+
+template<>
+const KernelTable<double>& getKernels<double>()
+{
+#if KERNELS_X86
+    static const KernelTable<double>& table = selectKernels(kernelsGenericd, kernelsAVX2d, kernelsAVX512d);
+#else
+    static const KernelTable<double>& table = selectKernels(kernelsGenericd);
+#endif
+    return table;
+}
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// Kernels.h
+// =========
+// hot geometry kernels of the pipe generator with runtime CPU dispatch
+//
+// The same kernel source (KernelsImpl.h) is compiled several times for
+// different instruction sets (SSE2, AVX2, AVX-512). The best table supported
+// by the running CPU is selected once at startup via cpuid, so a binary built
+// without -march=native still uses the wide vector units on newer machines.
+//
+// The selection can be overridden for testing with the environment variable
+// PIPE_KERNEL_ISA=sse2|avx2|avx512 (or "generic" on non-x86 platforms). If the
+// requested ISA is not supported by the CPU, the best supported one is used.
+//
+// Rings of 9, 17, 33 or 49 points (8, 16, 32 or 48 sectors) are processed by
+// specializations with the ring size as a template parameter.
+//
+// Dependencies: Vector3
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef KERNELS_H_DEF
+#define KERNELS_H_DEF
+
+#include "Vectors.h"
+
+// ISA specific kernels are built with GCC/Clang target pragmas on x86 only
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 1
+#else
+#define KERNELS_X86 0
+#endif
+
+// instruction set levels in ascending order
+enum KernelIsa
+{
+    KERNEL_ISA_GENERIC = 0,     // baseline build (SSE2 on x86-64)
+    KERNEL_ISA_AVX2,            // AVX2 + FMA
+    KERNEL_ISA_AVX512           // AVX-512F + AVX-512VL
+};
+
+template<typename T>
+struct KernelTable
+{
+    const char* name;
+
+    // project ring vertices along direction onto the plane (normal, d)
+    // dst[i] = src[i] + dir * t, where normal.(src[i] + dir*t) + d = 0
+    // If dir is parallel to the plane, dst is filled with NaN
+    void (*projectRing)(const Vector3T<T>* src, int count, const Vector3T<T>& dir,
+                        const Vector3T<T>& normal, T d, Vector3T<T>* dst);
+
+    // radial unit normals of ring vertices from the center
+    // 1/sqrt uses the precision policy of VECTORS_PRECISION (see Vectors.h)
+    void (*computeRingNormals)(const Vector3T<T>* ring, int count, const Vector3T<T>& center,
+                               Vector3T<T>* dst);
+
+    // transform points with 4x4 column-major matrix, src and dst may be same
+    void (*transformPoints)(const T matrix[16], const Vector3T<T>* src, int count,
+                            Vector3T<T>* dst);
+
+    // interleaved triangle strip (GL_N3F_V3F) between 2 rings
+    // writes count * 12 floats: (n2, v2, n1, v1) for each vertex
+    // Double precision rings are converted to float vertices here.
+    void (*buildStrip)(const Vector3T<T>* ring1, const Vector3T<T>* normals1,
+                       const Vector3T<T>* ring2, const Vector3T<T>* normals2,
+                       int count, float* dst);
+
+    // batch intersections for sweep, clipping and picking
+    // Each writes count points to dst and mask[i] = 1 if i-th pair intersects;
+    // a parallel pair gets NaN point and mask 0. Return # of intersections.
+    // lines (points[i] + t * dirs[i]) with a plane (normal, d)
+    int (*intersectLinesPlane)(const Vector3T<T>* points, const Vector3T<T>* dirs, int count,
+                               const Vector3T<T>& normal, T d,
+                               Vector3T<T>* dst, unsigned char* mask);
+
+    // line i with plane i (normals[i], ds[i])
+    int (*intersectLinesPlanes)(const Vector3T<T>* points, const Vector3T<T>* dirs,
+                                const Vector3T<T>* normals, const T* ds, int count,
+                                Vector3T<T>* dst, unsigned char* mask);
+
+    // packet of rays in SoA layout (separate x, y, z arrays) with a plane
+    int (*intersectRaysPlane)(const T* px, const T* py, const T* pz,
+                              const T* vx, const T* vy, const T* vz, int count,
+                              const Vector3T<T>& normal, T d,
+                              T* dstX, T* dstY, T* dstZ, unsigned char* mask);
+
+    // line i of 1st set with line i of 2nd set, same as Line::intersect()
+    int (*intersectLinesLines)(const Vector3T<T>* points1, const Vector3T<T>* dirs1,
+                               const Vector3T<T>* points2, const Vector3T<T>* dirs2, int count,
+                               Vector3T<T>* dst, unsigned char* mask);
+
+    // spheres in SoA layout (x, y, z, radius) against planes (a, b, c, d),
+    // 4 values per plane with unit normals facing inside, e.g. a frustum
+    // mask[i] = 0 if i-th sphere is entirely behind any plane, otherwise 1
+    // Return # of spheres not culled.
+    int (*testSpheresPlanes)(const T* x, const T* y, const T* z, const T* radii, int count,
+                             const T* planes, int planeCount, unsigned char* mask);
+};
+
+// return the kernel table selected for this CPU (selected at first call)
+// (specialized for float and double)
+template<typename T>
+const KernelTable<T>& getKernels();
+template<> const KernelTable<float>& getKernels<float>();
+template<> const KernelTable<double>& getKernels<double>();
+
+// return the ISA of the selected kernel table
+KernelIsa getKernelIsa();
+
+// return the highest ISA supported by the CPU and OS
+KernelIsa detectKernelIsa();
+
+#endif
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// KernelsAVX2.cpp
+// ===============
+// geometry kernels compiled for AVX2 + FMA
+// It is only called after cpuid confirms AVX2 and FMA (see Kernels.cpp).
+//
+// Dependencies: Kernels, KernelsImpl
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include "Kernels.h"
+
+#if KERNELS_X86
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to=function)
+#else
+#pragma GCC push_options
+#pragma GCC optimize("tree-vectorize", "vect-cost-model=dynamic")
+#pragma GCC target("avx2,fma")
+#endif
+
+namespace
+{
+#include "KernelsImpl.h"
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+extern const KernelTable<float> kernelsAVX2f =
+{
+    "avx2",
+    projectRing<float>,
+    computeRingNormals<float>,
+    transformPoints<float>,
+    buildStrip<float>,
+    intersectLinesPlane<float>,
+    intersectLinesPlanes<float>,
+    intersectRaysPlane<float>,
+    intersectLinesLines<float>,
+    testSpheresPlanes<float>
+};
+
+extern const KernelTable<double> kernelsAVX2d =
+{
+    "avx2",
+    projectRing<double>,
+    computeRingNormals<double>,
+    transformPoints<double>,
+    buildStrip<double>,
+    intersectLinesPlane<double>,
+    intersectLinesPlanes<double>,
+    intersectRaysPlane<double>,
+    intersectLinesLines<double>,
+    testSpheresPlanes<double>
+};
+
+#endif
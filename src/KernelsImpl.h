@@ -0,0 +1,358 @@
+///////////////////////////////////////////////////////////////////////////////
+// KernelsImpl.h
+// =============
+// bodies of the geometry kernels shared by all ISA specific builds
+//
+// NOTE: This file has no include guard on purpose. It is included once by
+// each Kernels*.cpp inside an anonymous namespace, after all other headers and
+// after the target pragma of that ISA, so every copy is compiled for its own
+// instruction set. Do not call inline functions of other headers from here;
+// use plain arithmetic on the components so nothing built for a wider ISA
+// can leak into the rest of the program through shared inline symbols.
+//
+// The ring kernels are also instantiated for the common ring sizes, 9, 17, 33
+// and 49 points (8, 16, 32 and 48 sectors). With the size known at compile
+// time, the loops are unrolled and vectorized without remainder loops; each
+// kernel dispatches to them by the count at run time.
+//
+// Dependencies: Vector3
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// project ring vertices along the direction onto the plane
+// t = -(n.p + d) / (n.v), the denominator is same for all vertices
+// N > 0 is the ring size known at compile time, then count is ignored
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, int N>
+void projectRingN(const Vector3T<T>* src, int count, const Vector3T<T>& dir,
+                  const Vector3T<T>& normal, T d, Vector3T<T>* dst)
+{
+    if(N > 0) count = N;
+
+    const T vx = dir.x, vy = dir.y, vz = dir.z;
+    const T nx = normal.x, ny = normal.y, nz = normal.z;
+    const T dot2 = nx*vx + ny*vy + nz*vz;
+
+    // if denominator=0, no intersect
+    if(dot2 == 0)
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            dst[i].x = dst[i].y = dst[i].z = NAN;
+        }
+        return;
+    }
+
+    const T dot2Inv = T(-1) / dot2;
+    for(int i = 0; i < count; ++i)
+    {
+        T px = src[i].x, py = src[i].y, pz = src[i].z;
+        T t = (nx*px + ny*py + nz*pz + d) * dot2Inv;
+        dst[i].x = px + vx * t;
+        dst[i].y = py + vy * t;
+        dst[i].z = pz + vz * t;
+    }
+}
+
+template<typename T>
+void projectRing(const Vector3T<T>* src, int count, const Vector3T<T>& dir,
+                 const Vector3T<T>& normal, T d, Vector3T<T>* dst)
+{
+    switch(count)
+    {
+    case 9:  projectRingN<T, 9>(src, count, dir, normal, d, dst);  break;
+    case 17: projectRingN<T, 17>(src, count, dir, normal, d, dst); break;
+    case 33: projectRingN<T, 33>(src, count, dir, normal, d, dst); break;
+    case 49: projectRingN<T, 49>(src, count, dir, normal, d, dst); break;
+    default: projectRingN<T, 0>(src, count, dir, normal, d, dst);  break;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 1/sqrt(x) with the precision policy of Vectors.h (VECTORS_PRECISION)
+// It repeats inverseSqrt() with C math functions, so the loops calling it can
+// be vectorized for this ISA. For VECTORS_PRECISION_RSQRT, GCC turns the
+// exact form into (v)rsqrtps + Newton step with the fast-math and "recip"
+// option; other compilers keep the exact division.
+///////////////////////////////////////////////////////////////////////////////
+#if VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && KERNELS_X86 && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("fast-math")
+#pragma GCC target("recip")
+#endif
+inline float ringInvSqrt(float x)
+{
+#if VECTORS_PRECISION == VECTORS_PRECISION_FAST
+    float xhalf = 0.5f * x;
+    int i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5f3759df - (i>>1);
+    std::memcpy(&x, &i, sizeof(x));
+    return x * (1.5f - xhalf*x*x);
+#else
+    return 1.0f / sqrtf(x);
+#endif
+}
+
+inline double ringInvSqrt(double x)
+{
+#if VECTORS_PRECISION == VECTORS_PRECISION_FAST || (VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && !KERNELS_X86)
+    double xhalf = 0.5 * x;
+    long long i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5fe6eb50c7b537a9LL - (i>>1);
+    std::memcpy(&x, &i, sizeof(x));
+    x = x * (1.5 - xhalf*x*x);
+    return x * (1.5 - xhalf*x*x);
+#else
+    return 1.0 / sqrt(x);
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unit vectors from center to each ring vertex
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, int N>
+void computeRingNormalsN(const Vector3T<T>* ring, int count, const Vector3T<T>& center,
+                         Vector3T<T>* dst)
+{
+    if(N > 0) count = N;
+
+    const T cx = center.x, cy = center.y, cz = center.z;
+    for(int i = 0; i < count; ++i)
+    {
+        T x = ring[i].x - cx;
+        T y = ring[i].y - cy;
+        T z = ring[i].z - cz;
+        T invLength = ringInvSqrt(x*x + y*y + z*z);
+        dst[i].x = x * invLength;
+        dst[i].y = y * invLength;
+        dst[i].z = z * invLength;
+    }
+}
+
+template<typename T>
+void computeRingNormals(const Vector3T<T>* ring, int count, const Vector3T<T>& center,
+                        Vector3T<T>* dst)
+{
+    switch(count)
+    {
+    case 9:  computeRingNormalsN<T, 9>(ring, count, center, dst);  break;
+    case 17: computeRingNormalsN<T, 17>(ring, count, center, dst); break;
+    case 33: computeRingNormalsN<T, 33>(ring, count, center, dst); break;
+    case 49: computeRingNormalsN<T, 49>(ring, count, center, dst); break;
+    default: computeRingNormalsN<T, 0>(ring, count, center, dst);  break;
+    }
+}
+#if VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && KERNELS_X86 && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// multiply 4x4 matrix (column-major) to points, w is assumed 1
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void transformPoints(const T m[16], const Vector3T<T>* src, int count, Vector3T<T>* dst)
+{
+    const T m0 = m[0], m1 = m[1], m2 = m[2],
+            m4 = m[4], m5 = m[5], m6 = m[6],
+            m8 = m[8], m9 = m[9], m10= m[10],
+            m12= m[12],m13= m[13],m14= m[14];
+    for(int i = 0; i < count; ++i)
+    {
+        T x = src[i].x, y = src[i].y, z = src[i].z;
+        dst[i].x = m0*x + m4*y + m8*z  + m12;
+        dst[i].y = m1*x + m5*y + m9*z  + m13;
+        dst[i].z = m2*x + m6*y + m10*z + m14;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch line-plane intersection: line i = points[i] + t * dirs[i]
+// The loops have no branch; a parallel line gets NaN and mask 0, so they can
+// be vectorized. Return the number of intersections.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int intersectLinesPlane(const Vector3T<T>* points, const Vector3T<T>* dirs, int count,
+                        const Vector3T<T>& normal, T d, Vector3T<T>* dst, unsigned char* mask)
+{
+    const T nx = normal.x, ny = normal.y, nz = normal.z;
+    int hits = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        T px = points[i].x, py = points[i].y, pz = points[i].z;
+        T vx = dirs[i].x,   vy = dirs[i].y,   vz = dirs[i].z;
+        T dot2 = nx*vx + ny*vy + nz*vz;
+        bool ok = dot2 != 0;
+        T t = -(nx*px + ny*py + nz*pz + d) / (ok ? dot2 : T(1));
+        dst[i].x = ok ? px + vx * t : T(NAN);
+        dst[i].y = ok ? py + vy * t : T(NAN);
+        dst[i].z = ok ? pz + vz * t : T(NAN);
+        mask[i] = (unsigned char)ok;
+        hits += ok;
+    }
+    return hits;
+}
+
+// line i with plane i (normals[i], ds[i])
+template<typename T>
+int intersectLinesPlanes(const Vector3T<T>* points, const Vector3T<T>* dirs,
+                         const Vector3T<T>* normals, const T* ds, int count,
+                         Vector3T<T>* dst, unsigned char* mask)
+{
+    int hits = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        T px = points[i].x,  py = points[i].y,  pz = points[i].z;
+        T vx = dirs[i].x,    vy = dirs[i].y,    vz = dirs[i].z;
+        T nx = normals[i].x, ny = normals[i].y, nz = normals[i].z;
+        T dot2 = nx*vx + ny*vy + nz*vz;
+        bool ok = dot2 != 0;
+        T t = -(nx*px + ny*py + nz*pz + ds[i]) / (ok ? dot2 : T(1));
+        dst[i].x = ok ? px + vx * t : T(NAN);
+        dst[i].y = ok ? py + vy * t : T(NAN);
+        dst[i].z = ok ? pz + vz * t : T(NAN);
+        mask[i] = (unsigned char)ok;
+        hits += ok;
+    }
+    return hits;
+}
+
+// SoA packet of rays (px,py,pz) + t * (vx,vy,vz) with the plane
+template<typename T>
+int intersectRaysPlane(const T* px, const T* py, const T* pz,
+                       const T* vx, const T* vy, const T* vz, int count,
+                       const Vector3T<T>& normal, T d,
+                       T* dstX, T* dstY, T* dstZ, unsigned char* mask)
+{
+    const T nx = normal.x, ny = normal.y, nz = normal.z;
+    int hits = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        T dot2 = nx*vx[i] + ny*vy[i] + nz*vz[i];
+        bool ok = dot2 != 0;
+        T t = -(nx*px[i] + ny*py[i] + nz*pz[i] + d) / (ok ? dot2 : T(1));
+        dstX[i] = ok ? px[i] + vx[i] * t : T(NAN);
+        dstY[i] = ok ? py[i] + vy[i] * t : T(NAN);
+        dstZ[i] = ok ? pz[i] + vz[i] * t : T(NAN);
+        mask[i] = (unsigned char)ok;
+        hits += ok;
+    }
+    return hits;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch line-line intersection: line1 i = points1[i] + a * dirs1[i] with
+// line2 i = points2[i] + b * dirs2[i]
+// a = ((p2-p1) x v2).(v1 x v2) / (v1 x v2).(v1 x v2), same as Line::intersect()
+// Parallel lines get NaN and mask 0.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int intersectLinesLines(const Vector3T<T>* points1, const Vector3T<T>* dirs1,
+                        const Vector3T<T>* points2, const Vector3T<T>* dirs2, int count,
+                        Vector3T<T>* dst, unsigned char* mask)
+{
+    int hits = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        T p1x = points1[i].x, p1y = points1[i].y, p1z = points1[i].z;
+        T v1x = dirs1[i].x,   v1y = dirs1[i].y,   v1z = dirs1[i].z;
+        T v2x = dirs2[i].x,   v2y = dirs2[i].y,   v2z = dirs2[i].z;
+        T wx = points2[i].x - p1x, wy = points2[i].y - p1y, wz = points2[i].z - p1z;
+
+        // v3 = (p2 - p1) x v2, v4 = v1 x v2
+        T v3x = wy*v2z - wz*v2y, v3y = wz*v2x - wx*v2z, v3z = wx*v2y - wy*v2x;
+        T v4x = v1y*v2z - v1z*v2y, v4y = v1z*v2x - v1x*v2z, v4z = v1x*v2y - v1y*v2x;
+        T dot = v4x*v4x + v4y*v4y + v4z*v4z;
+        bool ok = dot != 0;
+        T alpha = (v3x*v4x + v3y*v4y + v3z*v4z) / (ok ? dot : T(1));
+        dst[i].x = ok ? p1x + alpha * v1x : T(NAN);
+        dst[i].y = ok ? p1y + alpha * v1y : T(NAN);
+        dst[i].z = ok ? p1z + alpha * v1z : T(NAN);
+        mask[i] = (unsigned char)ok;
+        hits += ok;
+    }
+    return hits;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch sphere-plane test for culling
+// The loop over the spheres runs once per plane and only narrows the mask,
+// so it has no branch and is vectorized across the spheres.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int testSpheresPlanes(const T* x, const T* y, const T* z, const T* radii, int count,
+                      const T* planes, int planeCount, unsigned char* mask)
+{
+    for(int i = 0; i < count; ++i)
+        mask[i] = 1;
+
+    for(int p = 0; p < planeCount; ++p)
+    {
+        const T a = planes[p*4], b = planes[p*4+1], c = planes[p*4+2], d = planes[p*4+3];
+        for(int i = 0; i < count; ++i)
+        {
+            T distance = a*x[i] + b*y[i] + c*z[i] + d;
+            mask[i] &= (unsigned char)(distance >= -radii[i]);
+        }
+    }
+
+    int visible = 0;
+    for(int i = 0; i < count; ++i)
+        visible += mask[i];
+    return visible;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// interleave 2 rings into a triangle strip with GL_N3F_V3F layout
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, int N>
+void buildStripN(const Vector3T<T>* ring1, const Vector3T<T>* normals1,
+                 const Vector3T<T>* ring2, const Vector3T<T>* normals2,
+                 int count, float* dst)
+{
+    if(N > 0) count = N;
+
+    for(int i = 0; i < count; ++i)
+    {
+        float* v = dst + i * 12;
+        v[0] = (float)normals2[i].x;   v[1] = (float)normals2[i].y;   v[2] = (float)normals2[i].z;
+        v[3] = (float)ring2[i].x;      v[4] = (float)ring2[i].y;      v[5] = (float)ring2[i].z;
+        v[6] = (float)normals1[i].x;   v[7] = (float)normals1[i].y;   v[8] = (float)normals1[i].z;
+        v[9] = (float)ring1[i].x;      v[10]= (float)ring1[i].y;      v[11]= (float)ring1[i].z;
+    }
+}
+
+template<typename T>
+void buildStrip(const Vector3T<T>* ring1, const Vector3T<T>* normals1,
+                const Vector3T<T>* ring2, const Vector3T<T>* normals2,
+                int count, float* dst)
+{
+    switch(count)
+    {
+    case 9:  buildStripN<T, 9>(ring1, normals1, ring2, normals2, count, dst);  break;
+    case 17: buildStripN<T, 17>(ring1, normals1, ring2, normals2, count, dst); break;
+    case 33: buildStripN<T, 33>(ring1, normals1, ring2, normals2, count, dst); break;
+    case 49: buildStripN<T, 49>(ring1, normals1, ring2, normals2, count, dst); break;
+    default: buildStripN<T, 0>(ring1, normals1, ring2, normals2, count, dst);  break;
+    }
+}
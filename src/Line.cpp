@@ -4,22 +4,25 @@
 // class to construct a line with parametric form
 // Line = p + aV (a point and a direction vector on the line)
 //
-// Dependency: Vector2, Vector3
+// Dependency: Vector2, Vector3, VectorExpr, Kernels
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2015-12-18
-// UPDATED: 2020-07-17
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
 #include "Line.h"
+#include "VectorExpr.h"
+#include "Kernels.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // ctor
 // convert 2D slope-intercept form to parametric form
 ///////////////////////////////////////////////////////////////////////////////
-Line::Line(float slope, float intercept)
+template<typename T>
+LineT<T>::LineT(T slope, T intercept)
 {
     set(slope, intercept);
 }
@@ -29,7 +32,8 @@ Line::Line(float slope, float intercept)
 ///////////////////////////////////////////////////////////////////////////////
 // ctor with 2D direction and point
 ///////////////////////////////////////////////////////////////////////////////
-Line::Line(const Vector2& direction, const Vector2& point)
+template<typename T>
+LineT<T>::LineT(const Vector2T<T>& direction, const Vector2T<T>& point)
 {
     set(direction, point);
 }
@@ -39,24 +43,27 @@ Line::Line(const Vector2& direction, const Vector2& point)
 ///////////////////////////////////////////////////////////////////////////////
 // setters
 ///////////////////////////////////////////////////////////////////////////////
-void Line::set(const Vector3& v, const Vector3& p)
+template<typename T>
+void LineT<T>::set(const Vector3T<T>& v, const Vector3T<T>& p)
 {
     this->direction = v;
     this->point = p;
 }
 
-void Line::set(const Vector2& v, const Vector2& p)
+template<typename T>
+void LineT<T>::set(const Vector2T<T>& v, const Vector2T<T>& p)
 {
     // convert 2D to 3D
-    this->direction = Vector3(v.x, v.y, 0);
-    this->point = Vector3(p.x, p.y, 0);
+    this->direction = Vector3T<T>(v.x, v.y, 0);
+    this->point = Vector3T<T>(p.x, p.y, 0);
 }
 
-void Line::set(float slope, float intercept)
+template<typename T>
+void LineT<T>::set(T slope, T intercept)
 {
     // convert slope-intercept form (2D) to parametric form (3D)
-    this->direction = Vector3(1, slope, 0);
-    this->point = Vector3(0, intercept, 0);
+    this->direction = Vector3T<T>(1, slope, 0);
+    this->point = Vector3T<T>(0, intercept, 0);
 }
 
 
@@ -64,7 +71,8 @@ void Line::set(float slope, float intercept)
 ///////////////////////////////////////////////////////////////////////////////
 // debug
 ///////////////////////////////////////////////////////////////////////////////
-void Line::printSelf()
+template<typename T>
+void LineT<T>::printSelf()
 {
     std::cout << "Line\n"
               << "====\n"
@@ -88,34 +96,35 @@ void Line::printSelf()
 //        a = (p2-p1)xV2 / (V1xV2)
 //        a = ((p2-p1)xV2).(V1xV2) / (V1xV2).(V1xV2)
 ///////////////////////////////////////////////////////////////////////////////
-Vector3 Line::intersect(const Line& line)
+template<typename T>
+Vector3T<T> LineT<T>::intersect(const LineT& line)
 {
-    const Vector3 v2 = line.getDirection();
-    const Vector3 p2 = line.getPoint();
-    Vector3 result = Vector3(NAN, NAN, NAN);    // default with NaN
+    const Vector3T<T>& v2 = line.getDirection();
+    const Vector3T<T>& p2 = line.getPoint();
+    Vector3T<T> result = Vector3T<T>(NAN, NAN, NAN);    // default with NaN
 
     // find v3 = (p2 - p1) x V2
-    Vector3 v3 = (p2 - point).cross(v2);
+    Vector3T<T> v3 = (p2 - point).cross(v2);
 
     // find v4 = V1 x V2
-    Vector3 v4 = direction.cross(v2);
+    Vector3T<T> v4 = direction.cross(v2);
 
     // find (V1xV2) . (V1xV2)
-    float dot = v4.dot(v4);
+    T dot = v4.dot(v4);
 
     // if both V1 and V2 are same direction, return NaN point
     if(dot == 0)
         return result;
 
     // find a = ((p2-p1)xV2).(V1xV2) / (V1xV2).(V1xV2)
-    float alpha = v3.dot(v4) / dot;
+    T alpha = v3.dot(v4) / dot;
 
     /*
     // if both V1 and V2 are same direction, return NaN point
     if(v4.x == 0 && v4.y == 0 && v4.z == 0)
         return result;
 
-    float alpha = 0;
+    T alpha = 0;
     if(v4.x != 0)
         alpha = v3.x / v4.x;
     else if(v4.y != 0)
@@ -126,8 +135,8 @@ Vector3 Line::intersect(const Line& line)
         return result;
     */
 
-    // find intersect point
-    result = point + (alpha * direction);
+    // find intersect point (fused, no temporary for alpha * direction)
+    result = vexpr(point) + alpha * vexpr(direction);
     return result;
 }
 
@@ -136,12 +145,54 @@ Vector3 Line::intersect(const Line& line)
 ///////////////////////////////////////////////////////////////////////////////
 // determine if it intersects with the other line
 ///////////////////////////////////////////////////////////////////////////////
-bool Line::isIntersected(const Line& line)
+template<typename T>
+bool LineT<T>::isIntersected(const LineT& line)
 {
     // if 2 lines are same direction, the magnitude of cross product is 0
-    Vector3 v = this->direction.cross(line.getDirection());
+    Vector3T<T> v = this->direction.cross(line.getDirection());
     if(v.x == 0 && v.y == 0 && v.z == 0)
         return false;
     else
         return true;
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch intersection of lines1[i] and lines2[i]
+// Line objects are copied to small blocks on stack for the kernel.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int LineT<T>::intersect(const LineT* lines1, const LineT* lines2, int count,
+                        Vector3T<T>* dst, unsigned char* mask)
+{
+    const int BLOCK = 64;
+    Vector3T<T> points1[BLOCK];
+    Vector3T<T> dirs1[BLOCK];
+    Vector3T<T> points2[BLOCK];
+    Vector3T<T> dirs2[BLOCK];
+    const KernelTable<T>& kernels = getKernels<T>();
+
+    int hits = 0;
+    for(int i = 0; i < count; i += BLOCK)
+    {
+        int n = (count - i < BLOCK) ? count - i : BLOCK;
+        for(int j = 0; j < n; ++j)
+        {
+            points1[j] = lines1[i + j].point;
+            dirs1[j] = lines1[i + j].direction;
+            points2[j] = lines2[i + j].point;
+            dirs2[j] = lines2[i + j].direction;
+        }
+        hits += kernels.intersectLinesLines(points1, dirs1, points2, dirs2, n, dst + i, mask + i);
+    }
+    return hits;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation for single and double precision
+///////////////////////////////////////////////////////////////////////////////
+template class LineT<float>;
+template class LineT<double>;
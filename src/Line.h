@@ -8,7 +8,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2015-12-18
-// UPDATED: 2020-07-17
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef LINE_H_DEF
@@ -19,36 +19,47 @@
 
 
 
-class Line
+template<typename T>
+class LineT
 {
 public:
     // ctor/dtor
-    Line() : direction(Vector3(0,0,0)), point(Vector3(0,0,0)) {}
-    Line(const Vector3& v, const Vector3& p) : direction(v), point(p) {}    // with 3D direction and a point
-    Line(const Vector2& v, const Vector2& p);                               // with 2D direction and a point
-    Line(float slope, float intercept);                                     // with 2D slope-intercept form
-    ~Line() {};
+    LineT() : direction(Vector3T<T>(0,0,0)), point(Vector3T<T>(0,0,0)) {}
+    LineT(const Vector3T<T>& v, const Vector3T<T>& p) : direction(v), point(p) {}   // with 3D direction and a point
+    LineT(const Vector2T<T>& v, const Vector2T<T>& p);                             // with 2D direction and a point
+    LineT(T slope, T intercept);                                                    // with 2D slope-intercept form
+    ~LineT() {};
 
     // getters/setters
-    void set(const Vector3& v, const Vector3& p);               // from 3D
-    void set(const Vector2& v, const Vector2& p);               // from 2D
-    void set(float slope, float intercept);                     // from slope-intercept form
-    void setPoint(Vector3& p)           { point = p; }
-    void setDirection(const Vector3& v) { direction = v; }
-    const Vector3& getPoint() const     { return point; }
-    const Vector3& getDirection() const { return direction; }
+    void set(const Vector3T<T>& v, const Vector3T<T>& p);       // from 3D
+    void set(const Vector2T<T>& v, const Vector2T<T>& p);       // from 2D
+    void set(T slope, T intercept);                             // from slope-intercept form
+    void setPoint(Vector3T<T>& p)           { point = p; }
+    void setDirection(const Vector3T<T>& v) { direction = v; }
+    const Vector3T<T>& getPoint() const     { return point; }
+    const Vector3T<T>& getDirection() const { return direction; }
     void printSelf();
 
     // find intersect point with other line
-    Vector3 intersect(const Line& line);
-    bool isIntersected(const Line& line);
+    Vector3T<T> intersect(const LineT& line);
+    bool isIntersected(const LineT& line);
+
+    // batch intersection of lines1[i] and lines2[i], written to dst (count points)
+    // mask[i] = 1 if they intersect, otherwise 0 and dst[i] = NaN
+    // return # of intersections
+    static int intersect(const LineT* lines1, const LineT* lines2, int count,
+                         Vector3T<T>* dst, unsigned char* mask);
 
 protected:
 
 private:
-    Vector3 direction;
-    Vector3 point;
+    Vector3T<T> direction;
+    Vector3T<T> point;
 };
 
+// aliases for single and double precision
+typedef LineT<float>  Line;
+typedef LineT<double> Lined;
+
 #endif
 
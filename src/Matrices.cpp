@@ -22,8 +22,8 @@
 #include <algorithm>
 #include "Matrices.h"
 
-const float DEG2RAD = 3.141593f / 180.0f;
-const float RAD2DEG = 180.0f / 3.141593f;
+const double DEG2RAD = 3.141592653589793 / 180.0;
+const double RAD2DEG = 180.0 / 3.141592653589793;
 const float EPSILON = 0.00001f;
 
 
@@ -31,7 +31,8 @@ const float EPSILON = 0.00001f;
 ///////////////////////////////////////////////////////////////////////////////
 // transpose 2x2 matrix
 ///////////////////////////////////////////////////////////////////////////////
-Matrix2& Matrix2::transpose()
+template<typename T>
+Matrix2T<T>& Matrix2T<T>::transpose()
 {
     std::swap(m[1],  m[2]);
     return *this;
@@ -42,7 +43,8 @@ Matrix2& Matrix2::transpose()
 ///////////////////////////////////////////////////////////////////////////////
 // return the determinant of 2x2 matrix
 ///////////////////////////////////////////////////////////////////////////////
-float Matrix2::getDeterminant() const
+template<typename T>
+T Matrix2T<T>::getDeterminant() const
 {
     return m[0] * m[3] - m[1] * m[2];
 }
@@ -53,16 +55,17 @@ float Matrix2::getDeterminant() const
 // inverse of 2x2 matrix
 // If cannot find inverse, set identity matrix
 ///////////////////////////////////////////////////////////////////////////////
-Matrix2& Matrix2::invert()
+template<typename T>
+Matrix2T<T>& Matrix2T<T>::invert()
 {
-    float determinant = getDeterminant();
+    T determinant = getDeterminant();
     if(fabs(determinant) <= EPSILON)
     {
         return identity();
     }
 
-    float tmp = m[0];   // copy the first element
-    float invDeterminant = 1.0f / determinant;
+    T tmp = m[0];   // copy the first element
+    T invDeterminant = T(1) / determinant;
     m[0] =  invDeterminant * m[3];
     m[1] = -invDeterminant * m[1];
     m[2] = -invDeterminant * m[2];
@@ -79,10 +82,11 @@ Matrix2& Matrix2::invert()
 //     | s  c |
 // angle = atan(s / c)
 ///////////////////////////////////////////////////////////////////////////////
-float Matrix2::getAngle() const
+template<typename T>
+T Matrix2T<T>::getAngle() const
 {
     // angle between -pi ~ +pi (-180 ~ +180)
-    return RAD2DEG * atan2f(m[1], m[0]);
+    return T(RAD2DEG) * std::atan2(m[1], m[0]);
 }
 
 //=============================================================================
@@ -95,7 +99,8 @@ float Matrix2::getAngle() const
 ///////////////////////////////////////////////////////////////////////////////
 // transpose 3x3 matrix
 ///////////////////////////////////////////////////////////////////////////////
-Matrix3& Matrix3::transpose()
+template<typename T>
+Matrix3T<T>& Matrix3T<T>::transpose()
 {
     std::swap(m[1],  m[3]);
     std::swap(m[2],  m[6]);
@@ -109,7 +114,8 @@ Matrix3& Matrix3::transpose()
 ///////////////////////////////////////////////////////////////////////////////
 // return determinant of 3x3 matrix
 ///////////////////////////////////////////////////////////////////////////////
-float Matrix3::getDeterminant() const
+template<typename T>
+T Matrix3T<T>::getDeterminant() const
 {
     return m[0] * (m[4] * m[8] - m[5] * m[7]) -
            m[1] * (m[3] * m[8] - m[5] * m[6]) +
@@ -126,10 +132,11 @@ float Matrix3::getDeterminant() const
 //      = | m7m2-m8m1  m0m8-m2m6  m6m1-m7m0 | / det(M)
 //        | m1m5-m2m4  m2m3-m0m5  m0m4-m1m3 |
 ///////////////////////////////////////////////////////////////////////////////
-Matrix3& Matrix3::invert()
+template<typename T>
+Matrix3T<T>& Matrix3T<T>::invert()
 {
-    float determinant, invDeterminant;
-    float tmp[9];
+    T determinant, invDeterminant;
+    T tmp[9];
 
     tmp[0] = m[4] * m[8] - m[5] * m[7];
     tmp[1] = m[7] * m[2] - m[8] * m[1];
@@ -149,7 +156,7 @@ Matrix3& Matrix3::invert()
     }
 
     // divide by the determinant
-    invDeterminant = 1.0f / determinant;
+    invDeterminant = T(1) / determinant;
     m[0] = invDeterminant * tmp[0];
     m[1] = invDeterminant * tmp[1];
     m[2] = invDeterminant * tmp[2];
@@ -179,18 +186,19 @@ Matrix3& Matrix3::invert()
 // Yaw  : asin(m[6]) = asin(Sy)
 // Roll : atan(-m[3] / m[0]) = atan(SzCy/CzCy)
 ///////////////////////////////////////////////////////////////////////////////
-Vector3 Matrix3::getAngle() const
+template<typename T>
+Vector3T<T> Matrix3T<T>::getAngle() const
 {
-    float pitch, yaw, roll;         // 3 angles
+    T pitch, yaw, roll;         // 3 angles
 
     // find yaw (around y-axis) first
     // NOTE: asin() returns -90~+90, so correct the angle range -180~+180
     // using z value of forward vector
-    yaw = RAD2DEG * asinf(m[6]);
+    yaw = T(RAD2DEG) * std::asin(m[6]);
     if(m[8] < 0)
     {
-        if(yaw >= 0) yaw = 180.0f - yaw;
-        else         yaw =-180.0f - yaw;
+        if(yaw >= 0) yaw = T(180) - yaw;
+        else         yaw =-T(180) - yaw;
     }
 
     // find roll (around z-axis) and pitch (around x-axis)
@@ -198,15 +206,15 @@ Vector3 Matrix3::getAngle() const
     if(m[0] > -EPSILON && m[0] < EPSILON)
     {
         roll  = 0;  //@@ assume roll=0
-        pitch = RAD2DEG * atan2f(m[1], m[4]);
+        pitch = T(RAD2DEG) * std::atan2(m[1], m[4]);
     }
     else
     {
-        roll = RAD2DEG * atan2f(-m[3], m[0]);
-        pitch = RAD2DEG * atan2f(-m[7], m[8]);
+        roll = T(RAD2DEG) * std::atan2(-m[3], m[0]);
+        pitch = T(RAD2DEG) * std::atan2(-m[7], m[8]);
     }
 
-    return Vector3(pitch, yaw, roll);
+    return Vector3T<T>(pitch, yaw, roll);
 }
 
 //=============================================================================
@@ -219,7 +227,8 @@ Vector3 Matrix3::getAngle() const
 ///////////////////////////////////////////////////////////////////////////////
 // transpose 4x4 matrix
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::transpose()
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::transpose()
 {
     std::swap(m[1],  m[4]);
     std::swap(m[2],  m[8]);
@@ -236,7 +245,8 @@ Matrix4& Matrix4::transpose()
 ///////////////////////////////////////////////////////////////////////////////
 // inverse 4x4 matrix
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::invert()
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::invert()
 {
     // If the 4th row is [0,0,0,1] then it is affine matrix and
     // it has no projective transformation.
@@ -279,13 +289,14 @@ Matrix4& Matrix4::invert()
 //  [ --+-- ]   =  [ ----+--------- ]    (T denotes 1x3 translation)
 //  [ 0 | 1 ]      [  0  |     1    ]    (R^T denotes R-transpose)
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::invertEuclidean()
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::invertEuclidean()
 {
     // transpose 3x3 rotation matrix part
     // | R^T | 0 |
     // | ----+-- |
     // |  0  | 1 |
-    float tmp;
+    T tmp;
     tmp = m[1];  m[1] = m[4];  m[4] = tmp;
     tmp = m[2];  m[2] = m[8];  m[8] = tmp;
     tmp = m[6];  m[6] = m[9];  m[9] = tmp;
@@ -294,9 +305,9 @@ Matrix4& Matrix4::invertEuclidean()
     // | 0 | -R^T x |
     // | --+------- |
     // | 0 |   0    |
-    float x = m[12];
-    float y = m[13];
-    float z = m[14];
+    T x = m[12];
+    T y = m[13];
+    T z = m[14];
     m[12] = -(m[0] * x + m[4] * y + m[8] * z);
     m[13] = -(m[1] * x + m[5] * y + m[9] * z);
     m[14] = -(m[2] * x + m[6] * y + m[10]* z);
@@ -324,26 +335,27 @@ Matrix4& Matrix4::invertEuclidean()
 //  [ --+-- ]   = [ -----+---------- ]
 //  [ 0 | 1 ]     [  0   +     1     ]
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::invertAffine()
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::invertAffine()
 {
     // R^-1
-    Matrix3 r(m[0],m[1],m[2], m[4],m[5],m[6], m[8],m[9],m[10]);
+    Matrix3T<T> r(m[0],m[1],m[2], m[4],m[5],m[6], m[8],m[9],m[10]);
     r.invert();
     m[0] = r[0];  m[1] = r[1];  m[2] = r[2];
     m[4] = r[3];  m[5] = r[4];  m[6] = r[5];
     m[8] = r[6];  m[9] = r[7];  m[10]= r[8];
 
     // -R^-1 * T
-    float x = m[12];
-    float y = m[13];
-    float z = m[14];
+    T x = m[12];
+    T y = m[13];
+    T z = m[14];
     m[12] = -(r[0] * x + r[3] * y + r[6] * z);
     m[13] = -(r[1] * x + r[4] * y + r[7] * z);
     m[14] = -(r[2] * x + r[5] * y + r[8] * z);
 
     // last row should be unchanged (0,0,0,1)
-    //m[3] = m[7] = m[11] = 0.0f;
-    //m[15] = 1.0f;
+    //m[3] = m[7] = m[11] = T(0);
+    //m[15] = T(1);
 
     return * this;
 }
@@ -368,43 +380,44 @@ Matrix4& Matrix4::invertAffine()
 //       The matrix is invertable even if det(A)=0, so must check det(A) before
 //       calling this function, and use invertGeneric() instead.
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::invertProjective()
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::invertProjective()
 {
     // partition
-    Matrix2 a(m[0], m[1], m[4], m[5]);
-    Matrix2 b(m[8], m[9], m[12], m[13]);
-    Matrix2 c(m[2], m[3], m[6], m[7]);
-    Matrix2 d(m[10], m[11], m[14], m[15]);
+    Matrix2T<T> a(m[0], m[1], m[4], m[5]);
+    Matrix2T<T> b(m[8], m[9], m[12], m[13]);
+    Matrix2T<T> c(m[2], m[3], m[6], m[7]);
+    Matrix2T<T> d(m[10], m[11], m[14], m[15]);
 
     // pre-compute repeated parts
     a.invert();             // A^-1
-    Matrix2 ab = a * b;     // A^-1 * B
-    Matrix2 ca = c * a;     // C * A^-1
-    Matrix2 cab = ca * b;   // C * A^-1 * B
-    Matrix2 dcab = d - cab; // D - C * A^-1 * B
+    Matrix2T<T> ab = a * b;     // A^-1 * B
+    Matrix2T<T> ca = c * a;     // C * A^-1
+    Matrix2T<T> cab = ca * b;   // C * A^-1 * B
+    Matrix2T<T> dcab = d - cab; // D - C * A^-1 * B
 
     // check determinant if |D - C * A^-1 * B| = 0
     //NOTE: this function assumes det(A) is already checked. if |A|=0 then,
     //      cannot use this function.
-    float determinant = dcab[0] * dcab[3] - dcab[1] * dcab[2];
+    T determinant = dcab[0] * dcab[3] - dcab[1] * dcab[2];
     if(fabs(determinant) <= EPSILON)
     {
         return identity();
     }
 
     // compute D' and -D'
-    Matrix2 d1 = dcab;      //  (D - C * A^-1 * B)
+    Matrix2T<T> d1 = dcab;      //  (D - C * A^-1 * B)
     d1.invert();            //  (D - C * A^-1 * B)^-1
-    Matrix2 d2 = -d1;       // -(D - C * A^-1 * B)^-1
+    Matrix2T<T> d2 = -d1;       // -(D - C * A^-1 * B)^-1
 
     // compute C'
-    Matrix2 c1 = d2 * ca;   // -D' * (C * A^-1)
+    Matrix2T<T> c1 = d2 * ca;   // -D' * (C * A^-1)
 
     // compute B'
-    Matrix2 b1 = ab * d2;   // (A^-1 * B) * -D'
+    Matrix2T<T> b1 = ab * d2;   // (A^-1 * B) * -D'
 
     // compute A'
-    Matrix2 a1 = a - (ab * c1); // A^-1 - (A^-1 * B) * C'
+    Matrix2T<T> a1 = a - (ab * c1); // A^-1 - (A^-1 * B) * C'
 
     // assemble inverse matrix
     m[0] = a1[0];  m[4] = a1[2]; /*|*/ m[8] = b1[0];  m[12]= b1[2];
@@ -423,40 +436,41 @@ Matrix4& Matrix4::invertProjective()
 // If cannot find inverse, return indentity matrix
 // M^-1 = adj(M) / det(M)
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::invertGeneral()
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::invertGeneral()
 {
     // get cofactors of minor matrices
-    float cofactor0 = getCofactor(m[5],m[6],m[7], m[9],m[10],m[11], m[13],m[14],m[15]);
-    float cofactor1 = getCofactor(m[4],m[6],m[7], m[8],m[10],m[11], m[12],m[14],m[15]);
-    float cofactor2 = getCofactor(m[4],m[5],m[7], m[8],m[9], m[11], m[12],m[13],m[15]);
-    float cofactor3 = getCofactor(m[4],m[5],m[6], m[8],m[9], m[10], m[12],m[13],m[14]);
+    T cofactor0 = getCofactor(m[5],m[6],m[7], m[9],m[10],m[11], m[13],m[14],m[15]);
+    T cofactor1 = getCofactor(m[4],m[6],m[7], m[8],m[10],m[11], m[12],m[14],m[15]);
+    T cofactor2 = getCofactor(m[4],m[5],m[7], m[8],m[9], m[11], m[12],m[13],m[15]);
+    T cofactor3 = getCofactor(m[4],m[5],m[6], m[8],m[9], m[10], m[12],m[13],m[14]);
 
     // get determinant
-    float determinant = m[0] * cofactor0 - m[1] * cofactor1 + m[2] * cofactor2 - m[3] * cofactor3;
+    T determinant = m[0] * cofactor0 - m[1] * cofactor1 + m[2] * cofactor2 - m[3] * cofactor3;
     if(fabs(determinant) <= EPSILON)
     {
         return identity();
     }
 
     // get rest of cofactors for adj(M)
-    float cofactor4 = getCofactor(m[1],m[2],m[3], m[9],m[10],m[11], m[13],m[14],m[15]);
-    float cofactor5 = getCofactor(m[0],m[2],m[3], m[8],m[10],m[11], m[12],m[14],m[15]);
-    float cofactor6 = getCofactor(m[0],m[1],m[3], m[8],m[9], m[11], m[12],m[13],m[15]);
-    float cofactor7 = getCofactor(m[0],m[1],m[2], m[8],m[9], m[10], m[12],m[13],m[14]);
+    T cofactor4 = getCofactor(m[1],m[2],m[3], m[9],m[10],m[11], m[13],m[14],m[15]);
+    T cofactor5 = getCofactor(m[0],m[2],m[3], m[8],m[10],m[11], m[12],m[14],m[15]);
+    T cofactor6 = getCofactor(m[0],m[1],m[3], m[8],m[9], m[11], m[12],m[13],m[15]);
+    T cofactor7 = getCofactor(m[0],m[1],m[2], m[8],m[9], m[10], m[12],m[13],m[14]);
 
-    float cofactor8 = getCofactor(m[1],m[2],m[3], m[5],m[6], m[7],  m[13],m[14],m[15]);
-    float cofactor9 = getCofactor(m[0],m[2],m[3], m[4],m[6], m[7],  m[12],m[14],m[15]);
-    float cofactor10= getCofactor(m[0],m[1],m[3], m[4],m[5], m[7],  m[12],m[13],m[15]);
-    float cofactor11= getCofactor(m[0],m[1],m[2], m[4],m[5], m[6],  m[12],m[13],m[14]);
+    T cofactor8 = getCofactor(m[1],m[2],m[3], m[5],m[6], m[7],  m[13],m[14],m[15]);
+    T cofactor9 = getCofactor(m[0],m[2],m[3], m[4],m[6], m[7],  m[12],m[14],m[15]);
+    T cofactor10= getCofactor(m[0],m[1],m[3], m[4],m[5], m[7],  m[12],m[13],m[15]);
+    T cofactor11= getCofactor(m[0],m[1],m[2], m[4],m[5], m[6],  m[12],m[13],m[14]);
 
-    float cofactor12= getCofactor(m[1],m[2],m[3], m[5],m[6], m[7],  m[9], m[10],m[11]);
-    float cofactor13= getCofactor(m[0],m[2],m[3], m[4],m[6], m[7],  m[8], m[10],m[11]);
-    float cofactor14= getCofactor(m[0],m[1],m[3], m[4],m[5], m[7],  m[8], m[9], m[11]);
-    float cofactor15= getCofactor(m[0],m[1],m[2], m[4],m[5], m[6],  m[8], m[9], m[10]);
+    T cofactor12= getCofactor(m[1],m[2],m[3], m[5],m[6], m[7],  m[9], m[10],m[11]);
+    T cofactor13= getCofactor(m[0],m[2],m[3], m[4],m[6], m[7],  m[8], m[10],m[11]);
+    T cofactor14= getCofactor(m[0],m[1],m[3], m[4],m[5], m[7],  m[8], m[9], m[11]);
+    T cofactor15= getCofactor(m[0],m[1],m[2], m[4],m[5], m[6],  m[8], m[9], m[10]);
 
     // build inverse matrix = adj(M) / det(M)
     // adjugate of M is the transpose of the cofactor matrix of M
-    float invDeterminant = 1.0f / determinant;
+    T invDeterminant = T(1) / determinant;
     m[0] =  invDeterminant * cofactor0;
     m[1] = -invDeterminant * cofactor4;
     m[2] =  invDeterminant * cofactor8;
@@ -485,7 +499,8 @@ Matrix4& Matrix4::invertGeneral()
 ///////////////////////////////////////////////////////////////////////////////
 // return determinant of 4x4 matrix
 ///////////////////////////////////////////////////////////////////////////////
-float Matrix4::getDeterminant() const
+template<typename T>
+T Matrix4T<T>::getDeterminant() const
 {
     return m[0] * getCofactor(m[5],m[6],m[7], m[9],m[10],m[11], m[13],m[14],m[15]) -
            m[1] * getCofactor(m[4],m[6],m[7], m[8],m[10],m[11], m[12],m[14],m[15]) +
@@ -500,9 +515,10 @@ float Matrix4::getDeterminant() const
 // input params are 9 elements of the minor matrix
 // NOTE: The caller must know its sign.
 ///////////////////////////////////////////////////////////////////////////////
-float Matrix4::getCofactor(float m0, float m1, float m2,
-                           float m3, float m4, float m5,
-                           float m6, float m7, float m8) const
+template<typename T>
+T Matrix4T<T>::getCofactor(T m0, T m1, T m2,
+                           T m3, T m4, T m5,
+                           T m6, T m7, T m8) const
 {
     return m0 * (m4 * m8 - m5 * m7) -
            m1 * (m3 * m8 - m5 * m6) +
@@ -514,12 +530,14 @@ float Matrix4::getCofactor(float m0, float m1, float m2,
 ///////////////////////////////////////////////////////////////////////////////
 // translate this matrix by (x, y, z)
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::translate(const Vector3& v)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::translate(const Vector3T<T>& v)
 {
     return translate(v.x, v.y, v.z);
 }
 
-Matrix4& Matrix4::translate(float x, float y, float z)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::translate(T x, T y, T z)
 {
     m[0] += m[3] * x;   m[4] += m[7] * x;   m[8] += m[11]* x;   m[12]+= m[15]* x;
     m[1] += m[3] * y;   m[5] += m[7] * y;   m[9] += m[11]* y;   m[13]+= m[15]* y;
@@ -533,12 +551,14 @@ Matrix4& Matrix4::translate(float x, float y, float z)
 ///////////////////////////////////////////////////////////////////////////////
 // uniform scale
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::scale(float s)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::scale(T s)
 {
     return scale(s, s, s);
 }
 
-Matrix4& Matrix4::scale(float x, float y, float z)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::scale(T x, T y, T z)
 {
     m[0] *= x;   m[4] *= x;   m[8] *= x;   m[12] *= x;
     m[1] *= y;   m[5] *= y;   m[9] *= y;   m[13] *= y;
@@ -552,30 +572,32 @@ Matrix4& Matrix4::scale(float x, float y, float z)
 // build a rotation matrix with given angle(degree) and rotation axis, then
 // multiply it with this object
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::rotate(float angle, const Vector3& axis)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::rotate(T angle, const Vector3T<T>& axis)
 {
     return rotate(angle, axis.x, axis.y, axis.z);
 }
 
-Matrix4& Matrix4::rotate(float angle, float x, float y, float z)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::rotate(T angle, T x, T y, T z)
 {
-    float c = cosf(angle * DEG2RAD);    // cosine
-    float s = sinf(angle * DEG2RAD);    // sine
-    float c1 = 1.0f - c;                // 1 - c
-    float m0 = m[0],  m4 = m[4],  m8 = m[8],  m12= m[12],
-          m1 = m[1],  m5 = m[5],  m9 = m[9],  m13= m[13],
-          m2 = m[2],  m6 = m[6],  m10= m[10], m14= m[14];
+    T c = std::cos(angle * T(DEG2RAD));    // cosine
+    T s = std::sin(angle * T(DEG2RAD));    // sine
+    T c1 = T(1) - c;                // 1 - c
+    T m0 = m[0],  m4 = m[4],  m8 = m[8],  m12= m[12],
+      m1 = m[1],  m5 = m[5],  m9 = m[9],  m13= m[13],
+      m2 = m[2],  m6 = m[6],  m10= m[10], m14= m[14];
 
     // build rotation matrix
-    float r0 = x * x * c1 + c;
-    float r1 = x * y * c1 + z * s;
-    float r2 = x * z * c1 - y * s;
-    float r4 = x * y * c1 - z * s;
-    float r5 = y * y * c1 + c;
-    float r6 = y * z * c1 + x * s;
-    float r8 = x * z * c1 + y * s;
-    float r9 = y * z * c1 - x * s;
-    float r10= z * z * c1 + c;
+    T r0 = x * x * c1 + c;
+    T r1 = x * y * c1 + z * s;
+    T r2 = x * z * c1 - y * s;
+    T r4 = x * y * c1 - z * s;
+    T r5 = y * y * c1 + c;
+    T r6 = y * z * c1 + x * s;
+    T r8 = x * z * c1 + y * s;
+    T r9 = y * z * c1 - x * s;
+    T r10= z * z * c1 + c;
 
     // multiply rotation matrix
     m[0] = r0 * m0 + r4 * m1 + r8 * m2;
@@ -594,14 +616,15 @@ Matrix4& Matrix4::rotate(float angle, float x, float y, float z)
     return *this;
 }
 
-Matrix4& Matrix4::rotateX(float angle)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::rotateX(T angle)
 {
-    float c = cosf(angle * DEG2RAD);
-    float s = sinf(angle * DEG2RAD);
-    float m1 = m[1],  m2 = m[2],
-          m5 = m[5],  m6 = m[6],
-          m9 = m[9],  m10= m[10],
-          m13= m[13], m14= m[14];
+    T c = std::cos(angle * T(DEG2RAD));
+    T s = std::sin(angle * T(DEG2RAD));
+    T m1 = m[1],  m2 = m[2],
+      m5 = m[5],  m6 = m[6],
+      m9 = m[9],  m10= m[10],
+      m13= m[13], m14= m[14];
 
     m[1] = m1 * c + m2 *-s;
     m[2] = m1 * s + m2 * c;
@@ -615,14 +638,15 @@ Matrix4& Matrix4::rotateX(float angle)
     return *this;
 }
 
-Matrix4& Matrix4::rotateY(float angle)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::rotateY(T angle)
 {
-    float c = cosf(angle * DEG2RAD);
-    float s = sinf(angle * DEG2RAD);
-    float m0 = m[0],  m2 = m[2],
-          m4 = m[4],  m6 = m[6],
-          m8 = m[8],  m10= m[10],
-          m12= m[12], m14= m[14];
+    T c = std::cos(angle * T(DEG2RAD));
+    T s = std::sin(angle * T(DEG2RAD));
+    T m0 = m[0],  m2 = m[2],
+      m4 = m[4],  m6 = m[6],
+      m8 = m[8],  m10= m[10],
+      m12= m[12], m14= m[14];
 
     m[0] = m0 * c + m2 * s;
     m[2] = m0 *-s + m2 * c;
@@ -636,14 +660,15 @@ Matrix4& Matrix4::rotateY(float angle)
     return *this;
 }
 
-Matrix4& Matrix4::rotateZ(float angle)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::rotateZ(T angle)
 {
-    float c = cosf(angle * DEG2RAD);
-    float s = sinf(angle * DEG2RAD);
-    float m0 = m[0],  m1 = m[1],
-          m4 = m[4],  m5 = m[5],
-          m8 = m[8],  m9 = m[9],
-          m12= m[12], m13= m[13];
+    T c = std::cos(angle * T(DEG2RAD));
+    T s = std::sin(angle * T(DEG2RAD));
+    T m0 = m[0],  m1 = m[1],
+      m4 = m[4],  m5 = m[5],
+      m8 = m[8],  m9 = m[9],
+      m12= m[12], m13= m[13];
 
     m[0] = m0 * c + m1 *-s;
     m[1] = m0 * s + m1 * c;
@@ -666,14 +691,15 @@ Matrix4& Matrix4::rotateZ(float angle)
 // translation values.
 // NOTE: It is for rotating object to look at the target, NOT for camera
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::lookAt(const Vector3& target)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::lookAt(const Vector3T<T>& target)
 {
     // compute forward vector and normalize
-    Vector3 position = Vector3(m[12], m[13], m[14]);
-    Vector3 forward = target - position;
+    Vector3T<T> position = Vector3T<T>(m[12], m[13], m[14]);
+    Vector3T<T> forward = target - position;
     forward.normalize();
-    Vector3 up;             // up vector of object
-    Vector3 left;           // left vector of object
+    Vector3T<T> up;             // up vector of object
+    Vector3T<T> left;           // left vector of object
 
     // compute temporal up vector
     // if forward vector is near Y-axis, use up vector (0,0,-1) or (0,0,1)
@@ -708,19 +734,20 @@ Matrix4& Matrix4::lookAt(const Vector3& target)
     return *this;
 }
 
-Matrix4& Matrix4::lookAt(const Vector3& target, const Vector3& upVec)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::lookAt(const Vector3T<T>& target, const Vector3T<T>& upVec)
 {
     // compute forward vector and normalize
-    Vector3 position = Vector3(m[12], m[13], m[14]);
-    Vector3 forward = target - position;
+    Vector3T<T> position = Vector3T<T>(m[12], m[13], m[14]);
+    Vector3T<T> forward = target - position;
     forward.normalize();
 
     // compute left vector
-    Vector3 left = upVec.cross(forward);
+    Vector3T<T> left = upVec.cross(forward);
     left.normalize();
 
     // compute orthonormal up vector
-    Vector3 up = forward.cross(left);
+    Vector3T<T> up = forward.cross(left);
     up.normalize();
 
     // NOTE: overwrite rotation and scale info of the current matrix
@@ -731,14 +758,16 @@ Matrix4& Matrix4::lookAt(const Vector3& target, const Vector3& upVec)
     return *this;
 }
 
-Matrix4& Matrix4::lookAt(float tx, float ty, float tz)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::lookAt(T tx, T ty, T tz)
 {
-    return lookAt(Vector3(tx, ty, tz));
+    return lookAt(Vector3T<T>(tx, ty, tz));
 }
 
-Matrix4& Matrix4::lookAt(float tx, float ty, float tz, float ux, float uy, float uz)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::lookAt(T tx, T ty, T tz, T ux, T uy, T uz)
 {
-    return lookAt(Vector3(tx, ty, tz), Vector3(ux, uy, uz));
+    return lookAt(Vector3T<T>(tx, ty, tz), Vector3T<T>(ux, uy, uz));
 }
 
 
@@ -746,9 +775,10 @@ Matrix4& Matrix4::lookAt(float tx, float ty, float tz, float ux, float uy, float
 ///////////////////////////////////////////////////////////////////////////////
 // return 3x3 matrix containing rotation only
 ///////////////////////////////////////////////////////////////////////////////
-Matrix3 Matrix4::getRotationMatrix() const
+template<typename T>
+Matrix3T<T> Matrix4T<T>::getRotationMatrix() const
 {
-    Matrix3 mat(m[0], m[1], m[2],
+    Matrix3T<T> mat(m[0], m[1], m[2],
                 m[4], m[5], m[6],
                 m[8], m[9], m[10]);
     return mat;
@@ -760,9 +790,10 @@ Matrix3 Matrix4::getRotationMatrix() const
 ///////////////////////////////////////////////////////////////////////////////
 // skew with a given angle on the axis
 ///////////////////////////////////////////////////////////////////////////////
-Matrix4& Matrix4::skew(float angle, const Vector3& axis)
+template<typename T>
+Matrix4T<T>& Matrix4T<T>::skew(T angle, const Vector3T<T>& axis)
 {
-    float t = tanf(angle * DEG2RAD);    // tangent
+    T t = std::tan(angle * T(DEG2RAD));    // tangent
     m[0] += m[1] * t;
     m[4] += m[5] * t;
     m[8] += m[9] * t;
@@ -787,18 +818,19 @@ Matrix4& Matrix4::skew(float angle, const Vector3& axis)
 // Yaw  : asin(m[8]) = asin(Sy)
 // Roll : atan(-m[4] / m[0]) = atan(SzCy/CzCy)
 ///////////////////////////////////////////////////////////////////////////////
-Vector3 Matrix4::getAngle() const
+template<typename T>
+Vector3T<T> Matrix4T<T>::getAngle() const
 {
-    float pitch, yaw, roll;         // 3 angles
+    T pitch, yaw, roll;         // 3 angles
 
     // find yaw (around y-axis) first
     // NOTE: asin() returns -90~+90, so correct the angle range -180~+180
     // using z value of forward vector
-    yaw = RAD2DEG * asinf(m[8]);
+    yaw = T(RAD2DEG) * std::asin(m[8]);
     if(m[10] < 0)
     {
-        if(yaw >= 0) yaw = 180.0f - yaw;
-        else         yaw =-180.0f - yaw;
+        if(yaw >= 0) yaw = T(180) - yaw;
+        else         yaw =-T(180) - yaw;
     }
 
     // find roll (around z-axis) and pitch (around x-axis)
@@ -806,13 +838,25 @@ Vector3 Matrix4::getAngle() const
     if(m[0] > -EPSILON && m[0] < EPSILON)
     {
         roll  = 0;  //@@ assume roll=0
-        pitch = RAD2DEG * atan2f(m[1], m[5]);
+        pitch = T(RAD2DEG) * std::atan2(m[1], m[5]);
     }
     else
     {
-        roll = RAD2DEG * atan2f(-m[4], m[0]);
-        pitch = RAD2DEG * atan2f(-m[9], m[10]);
+        roll = T(RAD2DEG) * std::atan2(-m[4], m[0]);
+        pitch = T(RAD2DEG) * std::atan2(-m[9], m[10]);
     }
 
-    return Vector3(pitch, yaw, roll);
+    return Vector3T<T>(pitch, yaw, roll);
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation for single and double precision
+///////////////////////////////////////////////////////////////////////////////
+template class Matrix2T<float>;
+template class Matrix3T<float>;
+template class Matrix4T<float>;
+template class Matrix2T<double>;
+template class Matrix3T<double>;
+template class Matrix4T<double>;
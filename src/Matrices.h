@@ -13,7 +13,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2005-06-24
-// UPDATED: 2016-07-07
+// UPDATED: 2026-10-18
 //
 // Copyright (C) 2005 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -28,54 +28,51 @@
 ///////////////////////////////////////////////////////////////////////////
 // 2x2 matrix
 ///////////////////////////////////////////////////////////////////////////
-class Matrix2
+template<typename T>
+class Matrix2T
 {
 public:
     // constructors
-    Matrix2();  // init with identity
-    Matrix2(const float src[4]);
-    Matrix2(float m0, float m1, float m2, float m3);
+    MATH_CONSTEXPR Matrix2T();                                         // init with identity
+    MATH_CONSTEXPR Matrix2T(const T src[4]);
+    MATH_CONSTEXPR Matrix2T(T m0, T m1, T m2, T m3);
 
-    void        set(const float src[4]);
-    void        set(float m0, float m1, float m2, float m3);
-    void        setRow(int index, const float row[2]);
-    void        setRow(int index, const Vector2& v);
-    void        setColumn(int index, const float col[2]);
-    void        setColumn(int index, const Vector2& v);
+    MATH_CONSTEXPR void        set(const T src[4]);
+    MATH_CONSTEXPR void        set(T m0, T m1, T m2, T m3);
+    MATH_CONSTEXPR void        setRow(int index, const T row[2]);
+    MATH_CONSTEXPR void        setRow(int index, const Vector2T<T>& v);
+    MATH_CONSTEXPR void        setColumn(int index, const T col[2]);
+    MATH_CONSTEXPR void        setColumn(int index, const Vector2T<T>& v);
 
-    const float* get() const;
-    float       getDeterminant() const;
-    float       getAngle() const;                       // retrieve angle (degree) from matrix
+    MATH_CONSTEXPR const T*    get() const;
+                   T           getDeterminant() const;
+                   T           getAngle() const;                       // retrieve angle (degree) from matrix
 
-    Matrix2&    identity();
-    Matrix2&    transpose();                            // transpose itself and return reference
-    Matrix2&    invert();
+    MATH_CONSTEXPR Matrix2T&   identity();
+                   Matrix2T&   transpose();                            // transpose itself and return reference
+                   Matrix2T&   invert();
 
     // operators
-    Matrix2     operator+(const Matrix2& rhs) const;    // add rhs
-    Matrix2     operator-(const Matrix2& rhs) const;    // subtract rhs
-    Matrix2&    operator+=(const Matrix2& rhs);         // add rhs and update this object
-    Matrix2&    operator-=(const Matrix2& rhs);         // subtract rhs and update this object
-    Vector2     operator*(const Vector2& rhs) const;    // multiplication: v' = M * v
-    Matrix2     operator*(const Matrix2& rhs) const;    // multiplication: M3 = M1 * M2
-    Matrix2&    operator*=(const Matrix2& rhs);         // multiplication: M1' = M1 * M2
-    bool        operator==(const Matrix2& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Matrix2& rhs) const;   // exact compare, no epsilon
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    // friends functions
-    friend Matrix2 operator-(const Matrix2& m);                     // unary operator (-)
-    friend Matrix2 operator*(float scalar, const Matrix2& m);       // pre-multiplication
-    friend Vector2 operator*(const Vector2& vec, const Matrix2& m); // pre-multiplication
-    friend std::ostream& operator<<(std::ostream& os, const Matrix2& m);
+    MATH_CONSTEXPR Matrix2T    operator+(const Matrix2T& rhs) const;   // add rhs
+    MATH_CONSTEXPR Matrix2T    operator-(const Matrix2T& rhs) const;   // subtract rhs
+    MATH_CONSTEXPR Matrix2T&   operator+=(const Matrix2T& rhs);        // add rhs and update this object
+    MATH_CONSTEXPR Matrix2T&   operator-=(const Matrix2T& rhs);        // subtract rhs and update this object
+    MATH_CONSTEXPR Vector2T<T> operator*(const Vector2T<T>& rhs) const; // multiplication: v' = M * v
+    MATH_CONSTEXPR Matrix2T    operator*(const Matrix2T& rhs) const;   // multiplication: M3 = M1 * M2
+    MATH_CONSTEXPR Matrix2T&   operator*=(const Matrix2T& rhs);        // multiplication: M1' = M1 * M2
+    MATH_CONSTEXPR bool        operator==(const Matrix2T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator!=(const Matrix2T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR T           operator[](int index) const;            // subscript operator v[0], v[1]
+    MATH_CONSTEXPR T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    // non-member operators -M, s*M, v*M and << are defined below
 
     // static functions
 
 protected:
 
 private:
-    float m[4];
+    T m[4];
 
 };
 
@@ -84,56 +81,53 @@ private:
 ///////////////////////////////////////////////////////////////////////////
 // 3x3 matrix
 ///////////////////////////////////////////////////////////////////////////
-class Matrix3
+template<typename T>
+class Matrix3T
 {
 public:
     // constructors
-    Matrix3();  // init with identity
-    Matrix3(const float src[9]);
-    Matrix3(float m0, float m1, float m2,           // 1st column
-            float m3, float m4, float m5,           // 2nd column
-            float m6, float m7, float m8);          // 3rd column
-
-    void        set(const float src[9]);
-    void        set(float m0, float m1, float m2,   // 1st column
-                    float m3, float m4, float m5,   // 2nd column
-                    float m6, float m7, float m8);  // 3rd column
-    void        setRow(int index, const float row[3]);
-    void        setRow(int index, const Vector3& v);
-    void        setColumn(int index, const float col[3]);
-    void        setColumn(int index, const Vector3& v);
-
-    const float* get() const;
-    float       getDeterminant() const;
-    Vector3     getAngle() const;                       // return (pitch, yaw, roll)
-
-    Matrix3&    identity();
-    Matrix3&    transpose();                            // transpose itself and return reference
-    Matrix3&    invert();
+    MATH_CONSTEXPR Matrix3T();                                         // init with identity
+    MATH_CONSTEXPR Matrix3T(const T src[9]);
+    MATH_CONSTEXPR Matrix3T(T m0, T m1, T m2,                          // 1st column
+                            T m3, T m4, T m5,                      // 2nd column
+                            T m6, T m7, T m8);                     // 3rd column
+
+    MATH_CONSTEXPR void        set(const T src[9]);
+    MATH_CONSTEXPR void        set(T m0, T m1, T m2,                   // 1st column
+                                   T m3, T m4, T m5,               // 2nd column
+                                   T m6, T m7, T m8);              // 3rd column
+    MATH_CONSTEXPR void        setRow(int index, const T row[3]);
+    MATH_CONSTEXPR void        setRow(int index, const Vector3T<T>& v);
+    MATH_CONSTEXPR void        setColumn(int index, const T col[3]);
+    MATH_CONSTEXPR void        setColumn(int index, const Vector3T<T>& v);
+
+    MATH_CONSTEXPR const T*    get() const;
+                   T           getDeterminant() const;
+                   Vector3T<T> getAngle() const;                       // return (pitch, yaw, roll)
+
+    MATH_CONSTEXPR Matrix3T&   identity();
+                   Matrix3T&   transpose();                            // transpose itself and return reference
+                   Matrix3T&   invert();
 
     // operators
-    Matrix3     operator+(const Matrix3& rhs) const;    // add rhs
-    Matrix3     operator-(const Matrix3& rhs) const;    // subtract rhs
-    Matrix3&    operator+=(const Matrix3& rhs);         // add rhs and update this object
-    Matrix3&    operator-=(const Matrix3& rhs);         // subtract rhs and update this object
-    Vector3     operator*(const Vector3& rhs) const;    // multiplication: v' = M * v
-    Matrix3     operator*(const Matrix3& rhs) const;    // multiplication: M3 = M1 * M2
-    Matrix3&    operator*=(const Matrix3& rhs);         // multiplication: M1' = M1 * M2
-    bool        operator==(const Matrix3& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Matrix3& rhs) const;   // exact compare, no epsilon
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    // friends functions
-    friend Matrix3 operator-(const Matrix3& m);                     // unary operator (-)
-    friend Matrix3 operator*(float scalar, const Matrix3& m);       // pre-multiplication
-    friend Vector3 operator*(const Vector3& vec, const Matrix3& m); // pre-multiplication
-    friend std::ostream& operator<<(std::ostream& os, const Matrix3& m);
+    MATH_CONSTEXPR Matrix3T    operator+(const Matrix3T& rhs) const;   // add rhs
+    MATH_CONSTEXPR Matrix3T    operator-(const Matrix3T& rhs) const;   // subtract rhs
+    MATH_CONSTEXPR Matrix3T&   operator+=(const Matrix3T& rhs);        // add rhs and update this object
+    MATH_CONSTEXPR Matrix3T&   operator-=(const Matrix3T& rhs);        // subtract rhs and update this object
+    MATH_CONSTEXPR Vector3T<T> operator*(const Vector3T<T>& rhs) const; // multiplication: v' = M * v
+    MATH_CONSTEXPR Matrix3T    operator*(const Matrix3T& rhs) const;   // multiplication: M3 = M1 * M2
+    MATH_CONSTEXPR Matrix3T&   operator*=(const Matrix3T& rhs);        // multiplication: M1' = M1 * M2
+    MATH_CONSTEXPR bool        operator==(const Matrix3T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator!=(const Matrix3T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR T           operator[](int index) const;            // subscript operator v[0], v[1]
+    MATH_CONSTEXPR T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    // non-member operators -M, s*M, v*M and << are defined below
 
 protected:
 
 private:
-    float m[9];
+    T m[9];
 
 };
 
@@ -142,98 +136,95 @@ private:
 ///////////////////////////////////////////////////////////////////////////
 // 4x4 matrix
 ///////////////////////////////////////////////////////////////////////////
-class Matrix4
+template<typename T>
+class Matrix4T
 {
 public:
     // constructors
-    Matrix4();  // init with identity
-    Matrix4(const float src[16]);
-    Matrix4(float m00, float m01, float m02, float m03, // 1st column
-            float m04, float m05, float m06, float m07, // 2nd column
-            float m08, float m09, float m10, float m11, // 3rd column
-            float m12, float m13, float m14, float m15);// 4th column
-
-    void        set(const float src[16]);
-    void        set(float m00, float m01, float m02, float m03, // 1st column
-                    float m04, float m05, float m06, float m07, // 2nd column
-                    float m08, float m09, float m10, float m11, // 3rd column
-                    float m12, float m13, float m14, float m15);// 4th column
-    void        setRow(int index, const float row[4]);
-    void        setRow(int index, const Vector4& v);
-    void        setRow(int index, const Vector3& v);
-    void        setColumn(int index, const float col[4]);
-    void        setColumn(int index, const Vector4& v);
-    void        setColumn(int index, const Vector3& v);
-
-    const float* get() const;
-    const float* getTranspose();                        // return transposed matrix
-    float       getDeterminant() const;
-    Matrix3     getRotationMatrix() const;              // return 3x3 rotation part
-    Vector3     getAngle() const;                       // return (pitch, yaw, roll)
-
-    Matrix4&    identity();
-    Matrix4&    transpose();                            // transpose itself and return reference
-    Matrix4&    invert();                               // check best inverse method before inverse
-    Matrix4&    invertEuclidean();                      // inverse of Euclidean transform matrix
-    Matrix4&    invertAffine();                         // inverse of affine transform matrix
-    Matrix4&    invertProjective();                     // inverse of projective matrix using partitioning
-    Matrix4&    invertGeneral();                        // inverse of generic matrix
+    MATH_CONSTEXPR Matrix4T();                                         // init with identity
+    MATH_CONSTEXPR Matrix4T(const T src[16]);
+    MATH_CONSTEXPR Matrix4T(T m00, T m01, T m02, T m03,                // 1st column
+                            T m04, T m05, T m06, T m07,                // 2nd column
+                            T m08, T m09, T m10, T m11,                // 3rd column
+                            T m12, T m13, T m14, T m15);               // 4th column
+
+    MATH_CONSTEXPR void        set(const T src[16]);
+    MATH_CONSTEXPR void        set(T m00, T m01, T m02, T m03,         // 1st column
+                                   T m04, T m05, T m06, T m07,         // 2nd column
+                                   T m08, T m09, T m10, T m11,         // 3rd column
+                                   T m12, T m13, T m14, T m15);        // 4th column
+    MATH_CONSTEXPR void        setRow(int index, const T row[4]);
+    MATH_CONSTEXPR void        setRow(int index, const Vector4T<T>& v);
+    MATH_CONSTEXPR void        setRow(int index, const Vector3T<T>& v);
+    MATH_CONSTEXPR void        setColumn(int index, const T col[4]);
+    MATH_CONSTEXPR void        setColumn(int index, const Vector4T<T>& v);
+    MATH_CONSTEXPR void        setColumn(int index, const Vector3T<T>& v);
+
+    MATH_CONSTEXPR const T*    get() const;
+    MATH_CONSTEXPR const T*    getTranspose();                         // return transposed matrix
+                   T           getDeterminant() const;
+                   Matrix3T<T> getRotationMatrix() const;              // return 3x3 rotation part
+                   Vector3T<T> getAngle() const;                       // return (pitch, yaw, roll)
+
+    MATH_CONSTEXPR Matrix4T&   identity();
+                   Matrix4T&   transpose();                            // transpose itself and return reference
+                   Matrix4T&   invert();                               // check best inverse method before inverse
+                   Matrix4T&   invertEuclidean();                      // inverse of Euclidean transform matrix
+                   Matrix4T&   invertAffine();                         // inverse of affine transform matrix
+                   Matrix4T&   invertProjective();                     // inverse of projective matrix using partitioning
+                   Matrix4T&   invertGeneral();                        // inverse of generic matrix
 
     // transform matrix
-    Matrix4&    translate(float x, float y, float z);   // translation by (x,y,z)
-    Matrix4&    translate(const Vector3& v);            //
-    Matrix4&    rotate(float angle, const Vector3& axis); // rotate angle(degree) along the given axix
-    Matrix4&    rotate(float angle, float x, float y, float z);
-    Matrix4&    rotateX(float angle);                   // rotate on X-axis with degree
-    Matrix4&    rotateY(float angle);                   // rotate on Y-axis with degree
-    Matrix4&    rotateZ(float angle);                   // rotate on Z-axis with degree
-    Matrix4&    scale(float scale);                     // uniform scale
-    Matrix4&    scale(float sx, float sy, float sz);    // scale by (sx, sy, sz) on each axis
-    Matrix4&    lookAt(float tx, float ty, float tz);   // face object to the target direction
-    Matrix4&    lookAt(float tx, float ty, float tz, float ux, float uy, float uz);
-    Matrix4&    lookAt(const Vector3& target);
-    Matrix4&    lookAt(const Vector3& target, const Vector3& up);
-    //@@Matrix4&    skew(float angle, const Vector3& axis); //
+                   Matrix4T&   translate(T x, T y, T z);               // translation by (x,y,z)
+                   Matrix4T&   translate(const Vector3T<T>& v);
+                   Matrix4T&   rotate(T angle, const Vector3T<T>& axis); // rotate angle(degree) along the given axix
+                   Matrix4T&   rotate(T angle, T x, T y, T z);
+                   Matrix4T&   rotateX(T angle);                       // rotate on X-axis with degree
+                   Matrix4T&   rotateY(T angle);                       // rotate on Y-axis with degree
+                   Matrix4T&   rotateZ(T angle);                       // rotate on Z-axis with degree
+                   Matrix4T&   scale(T scale);                         // uniform scale
+                   Matrix4T&   scale(T sx, T sy, T sz);                // scale by (sx, sy, sz) on each axis
+                   Matrix4T&   lookAt(T tx, T ty, T tz);               // face object to the target direction
+                   Matrix4T&   lookAt(T tx, T ty, T tz, T ux, T uy, T uz);
+                   Matrix4T&   lookAt(const Vector3T<T>& target);
+                   Matrix4T&   lookAt(const Vector3T<T>& target, const Vector3T<T>& up);
+    //@@Matrix4T&   skew(T angle, const Vector3T<T>& axis); //
 
     // operators
-    Matrix4     operator+(const Matrix4& rhs) const;    // add rhs
-    Matrix4     operator-(const Matrix4& rhs) const;    // subtract rhs
-    Matrix4&    operator+=(const Matrix4& rhs);         // add rhs and update this object
-    Matrix4&    operator-=(const Matrix4& rhs);         // subtract rhs and update this object
-    Vector4     operator*(const Vector4& rhs) const;    // multiplication: v' = M * v
-    Vector3     operator*(const Vector3& rhs) const;    // multiplication: v' = M * v
-    Matrix4     operator*(const Matrix4& rhs) const;    // multiplication: M3 = M1 * M2
-    Matrix4&    operator*=(const Matrix4& rhs);         // multiplication: M1' = M1 * M2
-    bool        operator==(const Matrix4& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Matrix4& rhs) const;   // exact compare, no epsilon
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    // friends functions
-    friend Matrix4 operator-(const Matrix4& m);                     // unary operator (-)
-    friend Matrix4 operator*(float scalar, const Matrix4& m);       // pre-multiplication
-    friend Vector3 operator*(const Vector3& vec, const Matrix4& m); // pre-multiplication
-    friend Vector4 operator*(const Vector4& vec, const Matrix4& m); // pre-multiplication
-    friend std::ostream& operator<<(std::ostream& os, const Matrix4& m);
+    MATH_CONSTEXPR Matrix4T    operator+(const Matrix4T& rhs) const;   // add rhs
+    MATH_CONSTEXPR Matrix4T    operator-(const Matrix4T& rhs) const;   // subtract rhs
+    MATH_CONSTEXPR Matrix4T&   operator+=(const Matrix4T& rhs);        // add rhs and update this object
+    MATH_CONSTEXPR Matrix4T&   operator-=(const Matrix4T& rhs);        // subtract rhs and update this object
+    MATH_CONSTEXPR Vector4T<T> operator*(const Vector4T<T>& rhs) const; // multiplication: v' = M * v
+    MATH_CONSTEXPR Vector3T<T> operator*(const Vector3T<T>& rhs) const; // multiplication: v' = M * v
+    MATH_CONSTEXPR Matrix4T    operator*(const Matrix4T& rhs) const;   // multiplication: M3 = M1 * M2
+    MATH_CONSTEXPR Matrix4T&   operator*=(const Matrix4T& rhs);        // multiplication: M1' = M1 * M2
+    MATH_CONSTEXPR bool        operator==(const Matrix4T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator!=(const Matrix4T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR T           operator[](int index) const;            // subscript operator v[0], v[1]
+    MATH_CONSTEXPR T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    // non-member operators -M, s*M, v*M and << are defined below
 
 protected:
 
 private:
-    float       getCofactor(float m0, float m1, float m2,
-                            float m3, float m4, float m5,
-                            float m6, float m7, float m8) const;
+    T           getCofactor(T m0, T m1, T m2,
+                            T m3, T m4, T m5,
+                            T m6, T m7, T m8) const;
 
-    float m[16];
-    float tm[16];                                       // transpose m
+    T m[16];
+    T tm[16];                                                          // transpose m
 
 };
 
 
 
 ///////////////////////////////////////////////////////////////////////////
-// inline functions for Matrix2
+// inline functions for Matrix2T
 ///////////////////////////////////////////////////////////////////////////
-inline Matrix2::Matrix2()
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>::Matrix2T() : m()
 {
     // initially identity matrix
     identity();
@@ -241,93 +232,106 @@ inline Matrix2::Matrix2()
 
 
 
-inline Matrix2::Matrix2(const float src[4])
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>::Matrix2T(const T src[4]) : m()
 {
     set(src);
 }
 
 
 
-inline Matrix2::Matrix2(float m0, float m1, float m2, float m3)
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>::Matrix2T(T m0, T m1, T m2, T m3) : m()
 {
     set(m0, m1, m2, m3);
 }
 
 
 
-inline void Matrix2::set(const float src[4])
+template<typename T>
+MATH_CONSTEXPR void Matrix2T<T>::set(const T src[4])
 {
     m[0] = src[0];  m[1] = src[1];  m[2] = src[2];  m[3] = src[3];
 }
 
 
 
-inline void Matrix2::set(float m0, float m1, float m2, float m3)
+template<typename T>
+MATH_CONSTEXPR void Matrix2T<T>::set(T m0, T m1, T m2, T m3)
 {
     m[0]= m0;  m[1] = m1;  m[2] = m2;  m[3]= m3;
 }
 
 
 
-inline void Matrix2::setRow(int index, const float row[2])
+template<typename T>
+MATH_CONSTEXPR void Matrix2T<T>::setRow(int index, const T row[2])
 {
     m[index] = row[0];  m[index + 2] = row[1];
 }
 
 
 
-inline void Matrix2::setRow(int index, const Vector2& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix2T<T>::setRow(int index, const Vector2T<T>& v)
 {
     m[index] = v.x;  m[index + 2] = v.y;
 }
 
 
 
-inline void Matrix2::setColumn(int index, const float col[2])
+template<typename T>
+MATH_CONSTEXPR void Matrix2T<T>::setColumn(int index, const T col[2])
 {
     m[index*2] = col[0];  m[index*2 + 1] = col[1];
 }
 
 
 
-inline void Matrix2::setColumn(int index, const Vector2& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix2T<T>::setColumn(int index, const Vector2T<T>& v)
 {
     m[index*2] = v.x;  m[index*2 + 1] = v.y;
 }
 
 
 
-inline const float* Matrix2::get() const
+template<typename T>
+MATH_CONSTEXPR const T* Matrix2T<T>::get() const
 {
     return m;
 }
 
 
 
-inline Matrix2& Matrix2::identity()
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>& Matrix2T<T>::identity()
 {
-    m[0] = m[3] = 1.0f;
-    m[1] = m[2] = 0.0f;
+    m[0] = m[3] = T(1);
+    m[1] = m[2] = T(0);
     return *this;
 }
 
 
 
-inline Matrix2 Matrix2::operator+(const Matrix2& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T> Matrix2T<T>::operator+(const Matrix2T<T>& rhs) const
 {
-    return Matrix2(m[0]+rhs[0], m[1]+rhs[1], m[2]+rhs[2], m[3]+rhs[3]);
+    return Matrix2T<T>(m[0]+rhs[0], m[1]+rhs[1], m[2]+rhs[2], m[3]+rhs[3]);
 }
 
 
 
-inline Matrix2 Matrix2::operator-(const Matrix2& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T> Matrix2T<T>::operator-(const Matrix2T<T>& rhs) const
 {
-    return Matrix2(m[0]-rhs[0], m[1]-rhs[1], m[2]-rhs[2], m[3]-rhs[3]);
+    return Matrix2T<T>(m[0]-rhs[0], m[1]-rhs[1], m[2]-rhs[2], m[3]-rhs[3]);
 }
 
 
 
-inline Matrix2& Matrix2::operator+=(const Matrix2& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>& Matrix2T<T>::operator+=(const Matrix2T<T>& rhs)
 {
     m[0] += rhs[0];  m[1] += rhs[1];  m[2] += rhs[2];  m[3] += rhs[3];
     return *this;
@@ -335,7 +339,8 @@ inline Matrix2& Matrix2::operator+=(const Matrix2& rhs)
 
 
 
-inline Matrix2& Matrix2::operator-=(const Matrix2& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>& Matrix2T<T>::operator-=(const Matrix2T<T>& rhs)
 {
     m[0] -= rhs[0];  m[1] -= rhs[1];  m[2] -= rhs[2];  m[3] -= rhs[3];
     return *this;
@@ -343,22 +348,25 @@ inline Matrix2& Matrix2::operator-=(const Matrix2& rhs)
 
 
 
-inline Vector2 Matrix2::operator*(const Vector2& rhs) const
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Matrix2T<T>::operator*(const Vector2T<T>& rhs) const
 {
-    return Vector2(m[0]*rhs.x + m[2]*rhs.y,  m[1]*rhs.x + m[3]*rhs.y);
+    return Vector2T<T>(m[0]*rhs.x + m[2]*rhs.y,  m[1]*rhs.x + m[3]*rhs.y);
 }
 
 
 
-inline Matrix2 Matrix2::operator*(const Matrix2& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T> Matrix2T<T>::operator*(const Matrix2T<T>& rhs) const
 {
-    return Matrix2(m[0]*rhs[0] + m[2]*rhs[1],  m[1]*rhs[0] + m[3]*rhs[1],
+    return Matrix2T<T>(m[0]*rhs[0] + m[2]*rhs[1],  m[1]*rhs[0] + m[3]*rhs[1],
                    m[0]*rhs[2] + m[2]*rhs[3],  m[1]*rhs[2] + m[3]*rhs[3]);
 }
 
 
 
-inline Matrix2& Matrix2::operator*=(const Matrix2& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T>& Matrix2T<T>::operator*=(const Matrix2T<T>& rhs)
 {
     *this = *this * rhs;
     return *this;
@@ -366,56 +374,64 @@ inline Matrix2& Matrix2::operator*=(const Matrix2& rhs)
 
 
 
-inline bool Matrix2::operator==(const Matrix2& rhs) const
+template<typename T>
+MATH_CONSTEXPR bool Matrix2T<T>::operator==(const Matrix2T<T>& rhs) const
 {
     return (m[0] == rhs[0]) && (m[1] == rhs[1]) && (m[2] == rhs[2]) && (m[3] == rhs[3]);
 }
 
 
 
-inline bool Matrix2::operator!=(const Matrix2& rhs) const
+template<typename T>
+MATH_CONSTEXPR bool Matrix2T<T>::operator!=(const Matrix2T<T>& rhs) const
 {
     return (m[0] != rhs[0]) || (m[1] != rhs[1]) || (m[2] != rhs[2]) || (m[3] != rhs[3]);
 }
 
 
 
-inline float Matrix2::operator[](int index) const
+template<typename T>
+MATH_CONSTEXPR T Matrix2T<T>::operator[](int index) const
 {
     return m[index];
 }
 
 
 
-inline float& Matrix2::operator[](int index)
+template<typename T>
+MATH_CONSTEXPR T& Matrix2T<T>::operator[](int index)
 {
     return m[index];
 }
 
 
 
-inline Matrix2 operator-(const Matrix2& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T> operator-(const Matrix2T<T>& rhs)
 {
-    return Matrix2(-rhs[0], -rhs[1], -rhs[2], -rhs[3]);
+    return Matrix2T<T>(-rhs[0], -rhs[1], -rhs[2], -rhs[3]);
 }
 
 
 
-inline Matrix2 operator*(float s, const Matrix2& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix2T<T> operator*(T s, const Matrix2T<T>& rhs)
 {
-    return Matrix2(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3]);
+    return Matrix2T<T>(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3]);
 }
 
 
 
-inline Vector2 operator*(const Vector2& v, const Matrix2& rhs)
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> operator*(const Vector2T<T>& v, const Matrix2T<T>& rhs)
 {
-    return Vector2(v.x*rhs[0] + v.y*rhs[1],  v.x*rhs[2] + v.y*rhs[3]);
+    return Vector2T<T>(v.x*rhs[0] + v.y*rhs[1],  v.x*rhs[2] + v.y*rhs[3]);
 }
 
 
 
-inline std::ostream& operator<<(std::ostream& os, const Matrix2& m)
+template<typename T>
+inline std::ostream& operator<<(std::ostream& os, const Matrix2T<T>& m)
 {
     os << std::fixed << std::setprecision(5);
     os << "[" << std::setw(10) << m[0] << " " << std::setw(10) << m[2] << "]\n"
@@ -429,9 +445,10 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix2& m)
 
 
 ///////////////////////////////////////////////////////////////////////////
-// inline functions for Matrix3
+// inline functions for Matrix3T
 ///////////////////////////////////////////////////////////////////////////
-inline Matrix3::Matrix3()
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>::Matrix3T() : m()
 {
     // initially identity matrix
     identity();
@@ -439,23 +456,26 @@ inline Matrix3::Matrix3()
 
 
 
-inline Matrix3::Matrix3(const float src[9])
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>::Matrix3T(const T src[9]) : m()
 {
     set(src);
 }
 
 
 
-inline Matrix3::Matrix3(float m0, float m1, float m2,
-                        float m3, float m4, float m5,
-                        float m6, float m7, float m8)
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>::Matrix3T(T m0, T m1, T m2,
+                                     T m3, T m4, T m5,
+                                     T m6, T m7, T m8) : m()
 {
     set(m0, m1, m2,  m3, m4, m5,  m6, m7, m8);
 }
 
 
 
-inline void Matrix3::set(const float src[9])
+template<typename T>
+MATH_CONSTEXPR void Matrix3T<T>::set(const T src[9])
 {
     m[0] = src[0];  m[1] = src[1];  m[2] = src[2];
     m[3] = src[3];  m[4] = src[4];  m[5] = src[5];
@@ -464,9 +484,10 @@ inline void Matrix3::set(const float src[9])
 
 
 
-inline void Matrix3::set(float m0, float m1, float m2,
-                         float m3, float m4, float m5,
-                         float m6, float m7, float m8)
+template<typename T>
+MATH_CONSTEXPR void Matrix3T<T>::set(T m0, T m1, T m2,
+                                     T m3, T m4, T m5,
+                                     T m6, T m7, T m8)
 {
     m[0] = m0;  m[1] = m1;  m[2] = m2;
     m[3] = m3;  m[4] = m4;  m[5] = m5;
@@ -475,69 +496,78 @@ inline void Matrix3::set(float m0, float m1, float m2,
 
 
 
-inline void Matrix3::setRow(int index, const float row[3])
+template<typename T>
+MATH_CONSTEXPR void Matrix3T<T>::setRow(int index, const T row[3])
 {
     m[index] = row[0];  m[index + 3] = row[1];  m[index + 6] = row[2];
 }
 
 
 
-inline void Matrix3::setRow(int index, const Vector3& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix3T<T>::setRow(int index, const Vector3T<T>& v)
 {
     m[index] = v.x;  m[index + 3] = v.y;  m[index + 6] = v.z;
 }
 
 
 
-inline void Matrix3::setColumn(int index, const float col[3])
+template<typename T>
+MATH_CONSTEXPR void Matrix3T<T>::setColumn(int index, const T col[3])
 {
     m[index*3] = col[0];  m[index*3 + 1] = col[1];  m[index*3 + 2] = col[2];
 }
 
 
 
-inline void Matrix3::setColumn(int index, const Vector3& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix3T<T>::setColumn(int index, const Vector3T<T>& v)
 {
     m[index*3] = v.x;  m[index*3 + 1] = v.y;  m[index*3 + 2] = v.z;
 }
 
 
 
-inline const float* Matrix3::get() const
+template<typename T>
+MATH_CONSTEXPR const T* Matrix3T<T>::get() const
 {
     return m;
 }
 
 
 
-inline Matrix3& Matrix3::identity()
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>& Matrix3T<T>::identity()
 {
-    m[0] = m[4] = m[8] = 1.0f;
-    m[1] = m[2] = m[3] = m[5] = m[6] = m[7] = 0.0f;
+    m[0] = m[4] = m[8] = T(1);
+    m[1] = m[2] = m[3] = m[5] = m[6] = m[7] = T(0);
     return *this;
 }
 
 
 
-inline Matrix3 Matrix3::operator+(const Matrix3& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T> Matrix3T<T>::operator+(const Matrix3T<T>& rhs) const
 {
-    return Matrix3(m[0]+rhs[0], m[1]+rhs[1], m[2]+rhs[2],
+    return Matrix3T<T>(m[0]+rhs[0], m[1]+rhs[1], m[2]+rhs[2],
                    m[3]+rhs[3], m[4]+rhs[4], m[5]+rhs[5],
                    m[6]+rhs[6], m[7]+rhs[7], m[8]+rhs[8]);
 }
 
 
 
-inline Matrix3 Matrix3::operator-(const Matrix3& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T> Matrix3T<T>::operator-(const Matrix3T<T>& rhs) const
 {
-    return Matrix3(m[0]-rhs[0], m[1]-rhs[1], m[2]-rhs[2],
+    return Matrix3T<T>(m[0]-rhs[0], m[1]-rhs[1], m[2]-rhs[2],
                    m[3]-rhs[3], m[4]-rhs[4], m[5]-rhs[5],
                    m[6]-rhs[6], m[7]-rhs[7], m[8]-rhs[8]);
 }
 
 
 
-inline Matrix3& Matrix3::operator+=(const Matrix3& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>& Matrix3T<T>::operator+=(const Matrix3T<T>& rhs)
 {
     m[0] += rhs[0];  m[1] += rhs[1];  m[2] += rhs[2];
     m[3] += rhs[3];  m[4] += rhs[4];  m[5] += rhs[5];
@@ -547,7 +577,8 @@ inline Matrix3& Matrix3::operator+=(const Matrix3& rhs)
 
 
 
-inline Matrix3& Matrix3::operator-=(const Matrix3& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>& Matrix3T<T>::operator-=(const Matrix3T<T>& rhs)
 {
     m[0] -= rhs[0];  m[1] -= rhs[1];  m[2] -= rhs[2];
     m[3] -= rhs[3];  m[4] -= rhs[4];  m[5] -= rhs[5];
@@ -557,25 +588,28 @@ inline Matrix3& Matrix3::operator-=(const Matrix3& rhs)
 
 
 
-inline Vector3 Matrix3::operator*(const Vector3& rhs) const
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Matrix3T<T>::operator*(const Vector3T<T>& rhs) const
 {
-    return Vector3(m[0]*rhs.x + m[3]*rhs.y + m[6]*rhs.z,
+    return Vector3T<T>(m[0]*rhs.x + m[3]*rhs.y + m[6]*rhs.z,
                    m[1]*rhs.x + m[4]*rhs.y + m[7]*rhs.z,
                    m[2]*rhs.x + m[5]*rhs.y + m[8]*rhs.z);
 }
 
 
 
-inline Matrix3 Matrix3::operator*(const Matrix3& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T> Matrix3T<T>::operator*(const Matrix3T<T>& rhs) const
 {
-    return Matrix3(m[0]*rhs[0] + m[3]*rhs[1] + m[6]*rhs[2],  m[1]*rhs[0] + m[4]*rhs[1] + m[7]*rhs[2],  m[2]*rhs[0] + m[5]*rhs[1] + m[8]*rhs[2],
+    return Matrix3T<T>(m[0]*rhs[0] + m[3]*rhs[1] + m[6]*rhs[2],  m[1]*rhs[0] + m[4]*rhs[1] + m[7]*rhs[2],  m[2]*rhs[0] + m[5]*rhs[1] + m[8]*rhs[2],
                    m[0]*rhs[3] + m[3]*rhs[4] + m[6]*rhs[5],  m[1]*rhs[3] + m[4]*rhs[4] + m[7]*rhs[5],  m[2]*rhs[3] + m[5]*rhs[4] + m[8]*rhs[5],
                    m[0]*rhs[6] + m[3]*rhs[7] + m[6]*rhs[8],  m[1]*rhs[6] + m[4]*rhs[7] + m[7]*rhs[8],  m[2]*rhs[6] + m[5]*rhs[7] + m[8]*rhs[8]);
 }
 
 
 
-inline Matrix3& Matrix3::operator*=(const Matrix3& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T>& Matrix3T<T>::operator*=(const Matrix3T<T>& rhs)
 {
     *this = *this * rhs;
     return *this;
@@ -583,7 +617,8 @@ inline Matrix3& Matrix3::operator*=(const Matrix3& rhs)
 
 
 
-inline bool Matrix3::operator==(const Matrix3& rhs) const
+template<typename T>
+MATH_CONSTEXPR bool Matrix3T<T>::operator==(const Matrix3T<T>& rhs) const
 {
     return (m[0] == rhs[0]) && (m[1] == rhs[1]) && (m[2] == rhs[2]) &&
            (m[3] == rhs[3]) && (m[4] == rhs[4]) && (m[5] == rhs[5]) &&
@@ -592,7 +627,8 @@ inline bool Matrix3::operator==(const Matrix3& rhs) const
 
 
 
-inline bool Matrix3::operator!=(const Matrix3& rhs) const
+template<typename T>
+MATH_CONSTEXPR bool Matrix3T<T>::operator!=(const Matrix3T<T>& rhs) const
 {
     return (m[0] != rhs[0]) || (m[1] != rhs[1]) || (m[2] != rhs[2]) ||
            (m[3] != rhs[3]) || (m[4] != rhs[4]) || (m[5] != rhs[5]) ||
@@ -601,42 +637,48 @@ inline bool Matrix3::operator!=(const Matrix3& rhs) const
 
 
 
-inline float Matrix3::operator[](int index) const
+template<typename T>
+MATH_CONSTEXPR T Matrix3T<T>::operator[](int index) const
 {
     return m[index];
 }
 
 
 
-inline float& Matrix3::operator[](int index)
+template<typename T>
+MATH_CONSTEXPR T& Matrix3T<T>::operator[](int index)
 {
     return m[index];
 }
 
 
 
-inline Matrix3 operator-(const Matrix3& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T> operator-(const Matrix3T<T>& rhs)
 {
-    return Matrix3(-rhs[0], -rhs[1], -rhs[2], -rhs[3], -rhs[4], -rhs[5], -rhs[6], -rhs[7], -rhs[8]);
+    return Matrix3T<T>(-rhs[0], -rhs[1], -rhs[2], -rhs[3], -rhs[4], -rhs[5], -rhs[6], -rhs[7], -rhs[8]);
 }
 
 
 
-inline Matrix3 operator*(float s, const Matrix3& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T> operator*(T s, const Matrix3T<T>& rhs)
 {
-    return Matrix3(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3], s*rhs[4], s*rhs[5], s*rhs[6], s*rhs[7], s*rhs[8]);
+    return Matrix3T<T>(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3], s*rhs[4], s*rhs[5], s*rhs[6], s*rhs[7], s*rhs[8]);
 }
 
 
 
-inline Vector3 operator*(const Vector3& v, const Matrix3& m)
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> operator*(const Vector3T<T>& v, const Matrix3T<T>& m)
 {
-    return Vector3(v.x*m[0] + v.y*m[1] + v.z*m[2],  v.x*m[3] + v.y*m[4] + v.z*m[5],  v.x*m[6] + v.y*m[7] + v.z*m[8]);
+    return Vector3T<T>(v.x*m[0] + v.y*m[1] + v.z*m[2],  v.x*m[3] + v.y*m[4] + v.z*m[5],  v.x*m[6] + v.y*m[7] + v.z*m[8]);
 }
 
 
 
-inline std::ostream& operator<<(std::ostream& os, const Matrix3& m)
+template<typename T>
+inline std::ostream& operator<<(std::ostream& os, const Matrix3T<T>& m)
 {
     os << std::fixed << std::setprecision(5);
     os << "[" << std::setw(10) << m[0] << " " << std::setw(10) << m[3] << " " << std::setw(10) << m[6] << "]\n"
@@ -651,9 +693,10 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix3& m)
 
 
 ///////////////////////////////////////////////////////////////////////////
-// inline functions for Matrix4
+// inline functions for Matrix4T
 ///////////////////////////////////////////////////////////////////////////
-inline Matrix4::Matrix4()
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>::Matrix4T() : m(), tm()
 {
     // initially identity matrix
     identity();
@@ -661,24 +704,27 @@ inline Matrix4::Matrix4()
 
 
 
-inline Matrix4::Matrix4(const float src[16])
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>::Matrix4T(const T src[16]) : m(), tm()
 {
     set(src);
 }
 
 
 
-inline Matrix4::Matrix4(float m00, float m01, float m02, float m03,
-                        float m04, float m05, float m06, float m07,
-                        float m08, float m09, float m10, float m11,
-                        float m12, float m13, float m14, float m15)
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>::Matrix4T(T m00, T m01, T m02, T m03,
+                                     T m04, T m05, T m06, T m07,
+                                     T m08, T m09, T m10, T m11,
+                                     T m12, T m13, T m14, T m15) : m(), tm()
 {
     set(m00, m01, m02, m03,  m04, m05, m06, m07,  m08, m09, m10, m11,  m12, m13, m14, m15);
 }
 
 
 
-inline void Matrix4::set(const float src[16])
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::set(const T src[16])
 {
     m[0] = src[0];  m[1] = src[1];  m[2] = src[2];  m[3] = src[3];
     m[4] = src[4];  m[5] = src[5];  m[6] = src[6];  m[7] = src[7];
@@ -688,10 +734,11 @@ inline void Matrix4::set(const float src[16])
 
 
 
-inline void Matrix4::set(float m00, float m01, float m02, float m03,
-                         float m04, float m05, float m06, float m07,
-                         float m08, float m09, float m10, float m11,
-                         float m12, float m13, float m14, float m15)
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::set(T m00, T m01, T m02, T m03,
+                                     T m04, T m05, T m06, T m07,
+                                     T m08, T m09, T m10, T m11,
+                                     T m12, T m13, T m14, T m15)
 {
     m[0] = m00;  m[1] = m01;  m[2] = m02;  m[3] = m03;
     m[4] = m04;  m[5] = m05;  m[6] = m06;  m[7] = m07;
@@ -701,56 +748,64 @@ inline void Matrix4::set(float m00, float m01, float m02, float m03,
 
 
 
-inline void Matrix4::setRow(int index, const float row[4])
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::setRow(int index, const T row[4])
 {
     m[index] = row[0];  m[index + 4] = row[1];  m[index + 8] = row[2];  m[index + 12] = row[3];
 }
 
 
 
-inline void Matrix4::setRow(int index, const Vector4& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::setRow(int index, const Vector4T<T>& v)
 {
     m[index] = v.x;  m[index + 4] = v.y;  m[index + 8] = v.z;  m[index + 12] = v.w;
 }
 
 
 
-inline void Matrix4::setRow(int index, const Vector3& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::setRow(int index, const Vector3T<T>& v)
 {
     m[index] = v.x;  m[index + 4] = v.y;  m[index + 8] = v.z;
 }
 
 
 
-inline void Matrix4::setColumn(int index, const float col[4])
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::setColumn(int index, const T col[4])
 {
     m[index*4] = col[0];  m[index*4 + 1] = col[1];  m[index*4 + 2] = col[2];  m[index*4 + 3] = col[3];
 }
 
 
 
-inline void Matrix4::setColumn(int index, const Vector4& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::setColumn(int index, const Vector4T<T>& v)
 {
     m[index*4] = v.x;  m[index*4 + 1] = v.y;  m[index*4 + 2] = v.z;  m[index*4 + 3] = v.w;
 }
 
 
 
-inline void Matrix4::setColumn(int index, const Vector3& v)
+template<typename T>
+MATH_CONSTEXPR void Matrix4T<T>::setColumn(int index, const Vector3T<T>& v)
 {
     m[index*4] = v.x;  m[index*4 + 1] = v.y;  m[index*4 + 2] = v.z;
 }
 
 
 
-inline const float* Matrix4::get() const
+template<typename T>
+MATH_CONSTEXPR const T* Matrix4T<T>::get() const
 {
     return m;
 }
 
 
 
-inline const float* Matrix4::getTranspose()
+template<typename T>
+MATH_CONSTEXPR const T* Matrix4T<T>::getTranspose()
 {
     tm[0] = m[0];   tm[1] = m[4];   tm[2] = m[8];   tm[3] = m[12];
     tm[4] = m[1];   tm[5] = m[5];   tm[6] = m[9];   tm[7] = m[13];
@@ -761,18 +816,20 @@ inline const float* Matrix4::getTranspose()
 
 
 
-inline Matrix4& Matrix4::identity()
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>& Matrix4T<T>::identity()
 {
-    m[0] = m[5] = m[10] = m[15] = 1.0f;
-    m[1] = m[2] = m[3] = m[4] = m[6] = m[7] = m[8] = m[9] = m[11] = m[12] = m[13] = m[14] = 0.0f;
+    m[0] = m[5] = m[10] = m[15] = T(1);
+    m[1] = m[2] = m[3] = m[4] = m[6] = m[7] = m[8] = m[9] = m[11] = m[12] = m[13] = m[14] = T(0);
     return *this;
 }
 
 
 
-inline Matrix4 Matrix4::operator+(const Matrix4& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T> Matrix4T<T>::operator+(const Matrix4T<T>& rhs) const
 {
-    return Matrix4(m[0]+rhs[0],   m[1]+rhs[1],   m[2]+rhs[2],   m[3]+rhs[3],
+    return Matrix4T<T>(m[0]+rhs[0],   m[1]+rhs[1],   m[2]+rhs[2],   m[3]+rhs[3],
                    m[4]+rhs[4],   m[5]+rhs[5],   m[6]+rhs[6],   m[7]+rhs[7],
                    m[8]+rhs[8],   m[9]+rhs[9],   m[10]+rhs[10], m[11]+rhs[11],
                    m[12]+rhs[12], m[13]+rhs[13], m[14]+rhs[14], m[15]+rhs[15]);
@@ -780,9 +837,10 @@ inline Matrix4 Matrix4::operator+(const Matrix4& rhs) const
 
 
 
-inline Matrix4 Matrix4::operator-(const Matrix4& rhs) const
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T> Matrix4T<T>::operator-(const Matrix4T<T>& rhs) const
 {
-    return Matrix4(m[0]-rhs[0],   m[1]-rhs[1],   m[2]-rhs[2],   m[3]-rhs[3],
+    return Matrix4T<T>(m[0]-rhs[0],   m[1]-rhs[1],   m[2]-rhs[2],   m[3]-rhs[3],
                    m[4]-rhs[4],   m[5]-rhs[5],   m[6]-rhs[6],   m[7]-rhs[7],
                    m[8]-rhs[8],   m[9]-rhs[9],   m[10]-rhs[10], m[11]-rhs[11],
                    m[12]-rhs[12], m[13]-rhs[13], m[14]-rhs[14], m[15]-rhs[15]);
@@ -790,7 +848,8 @@ inline Matrix4 Matrix4::operator-(const Matrix4& rhs) const
 
 
 
-inline Matrix4& Matrix4::operator+=(const Matrix4& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>& Matrix4T<T>::operator+=(const Matrix4T<T>& rhs)
 {
     m[0] += rhs[0];   m[1] += rhs[1];   m[2] += rhs[2];   m[3] += rhs[3];
     m[4] += rhs[4];   m[5] += rhs[5];   m[6] += rhs[6];   m[7] += rhs[7];
@@ -801,7 +860,8 @@ inline Matrix4& Matrix4::operator+=(const Matrix4& rhs)
 
 
 
-inline Matrix4& Matrix4::operator-=(const Matrix4& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>& Matrix4T<T>::operator-=(const Matrix4T<T>& rhs)
 {
     m[0] -= rhs[0];   m[1] -= rhs[1];   m[2] -= rhs[2];   m[3] -= rhs[3];
     m[4] -= rhs[4];   m[5] -= rhs[5];   m[6] -= rhs[6];   m[7] -= rhs[7];
@@ -812,9 +872,10 @@ inline Matrix4& Matrix4::operator-=(const Matrix4& rhs)
 
 
 
-inline Vector4 Matrix4::operator*(const Vector4& rhs) const
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Matrix4T<T>::operator*(const Vector4T<T>& rhs) const
 {
-    return Vector4(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z  + m[12]*rhs.w,
+    return Vector4T<T>(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z  + m[12]*rhs.w,
                    m[1]*rhs.x + m[5]*rhs.y + m[9]*rhs.z  + m[13]*rhs.w,
                    m[2]*rhs.x + m[6]*rhs.y + m[10]*rhs.z + m[14]*rhs.w,
                    m[3]*rhs.x + m[7]*rhs.y + m[11]*rhs.z + m[15]*rhs.w);
@@ -822,18 +883,20 @@ inline Vector4 Matrix4::operator*(const Vector4& rhs) const
 
 
 
-inline Vector3 Matrix4::operator*(const Vector3& rhs) const
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Matrix4T<T>::operator*(const Vector3T<T>& rhs) const
 {
-    return Vector3(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z + m[12],
+    return Vector3T<T>(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z + m[12],
                    m[1]*rhs.x + m[5]*rhs.y + m[9]*rhs.z + m[13],
                    m[2]*rhs.x + m[6]*rhs.y + m[10]*rhs.z+ m[14]);
 }
 
 
 
-inline Matrix4 Matrix4::operator*(const Matrix4& n) const
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T> Matrix4T<T>::operator*(const Matrix4T<T>& n) const
 {
-    return Matrix4(m[0]*n[0]  + m[4]*n[1]  + m[8]*n[2]  + m[12]*n[3],   m[1]*n[0]  + m[5]*n[1]  + m[9]*n[2]  + m[13]*n[3],   m[2]*n[0]  + m[6]*n[1]  + m[10]*n[2]  + m[14]*n[3],   m[3]*n[0]  + m[7]*n[1]  + m[11]*n[2]  + m[15]*n[3],
+    return Matrix4T<T>(m[0]*n[0]  + m[4]*n[1]  + m[8]*n[2]  + m[12]*n[3],   m[1]*n[0]  + m[5]*n[1]  + m[9]*n[2]  + m[13]*n[3],   m[2]*n[0]  + m[6]*n[1]  + m[10]*n[2]  + m[14]*n[3],   m[3]*n[0]  + m[7]*n[1]  + m[11]*n[2]  + m[15]*n[3],
                    m[0]*n[4]  + m[4]*n[5]  + m[8]*n[6]  + m[12]*n[7],   m[1]*n[4]  + m[5]*n[5]  + m[9]*n[6]  + m[13]*n[7],   m[2]*n[4]  + m[6]*n[5]  + m[10]*n[6]  + m[14]*n[7],   m[3]*n[4]  + m[7]*n[5]  + m[11]*n[6]  + m[15]*n[7],
                    m[0]*n[8]  + m[4]*n[9]  + m[8]*n[10] + m[12]*n[11],  m[1]*n[8]  + m[5]*n[9]  + m[9]*n[10] + m[13]*n[11],  m[2]*n[8]  + m[6]*n[9]  + m[10]*n[10] + m[14]*n[11],  m[3]*n[8]  + m[7]*n[9]  + m[11]*n[10] + m[15]*n[11],
                    m[0]*n[12] + m[4]*n[13] + m[8]*n[14] + m[12]*n[15],  m[1]*n[12] + m[5]*n[13] + m[9]*n[14] + m[13]*n[15],  m[2]*n[12] + m[6]*n[13] + m[10]*n[14] + m[14]*n[15],  m[3]*n[12] + m[7]*n[13] + m[11]*n[14] + m[15]*n[15]);
@@ -841,7 +904,8 @@ inline Matrix4 Matrix4::operator*(const Matrix4& n) const
 
 
 
-inline Matrix4& Matrix4::operator*=(const Matrix4& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T>& Matrix4T<T>::operator*=(const Matrix4T<T>& rhs)
 {
     *this = *this * rhs;
     return *this;
@@ -849,7 +913,8 @@ inline Matrix4& Matrix4::operator*=(const Matrix4& rhs)
 
 
 
-inline bool Matrix4::operator==(const Matrix4& n) const
+template<typename T>
+MATH_CONSTEXPR bool Matrix4T<T>::operator==(const Matrix4T<T>& n) const
 {
     return (m[0] == n[0])  && (m[1] == n[1])  && (m[2] == n[2])  && (m[3] == n[3])  &&
            (m[4] == n[4])  && (m[5] == n[5])  && (m[6] == n[6])  && (m[7] == n[7])  &&
@@ -859,7 +924,8 @@ inline bool Matrix4::operator==(const Matrix4& n) const
 
 
 
-inline bool Matrix4::operator!=(const Matrix4& n) const
+template<typename T>
+MATH_CONSTEXPR bool Matrix4T<T>::operator!=(const Matrix4T<T>& n) const
 {
     return (m[0] != n[0])  || (m[1] != n[1])  || (m[2] != n[2])  || (m[3] != n[3])  ||
            (m[4] != n[4])  || (m[5] != n[5])  || (m[6] != n[6])  || (m[7] != n[7])  ||
@@ -869,49 +935,56 @@ inline bool Matrix4::operator!=(const Matrix4& n) const
 
 
 
-inline float Matrix4::operator[](int index) const
+template<typename T>
+MATH_CONSTEXPR T Matrix4T<T>::operator[](int index) const
 {
     return m[index];
 }
 
 
 
-inline float& Matrix4::operator[](int index)
+template<typename T>
+MATH_CONSTEXPR T& Matrix4T<T>::operator[](int index)
 {
     return m[index];
 }
 
 
 
-inline Matrix4 operator-(const Matrix4& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T> operator-(const Matrix4T<T>& rhs)
 {
-    return Matrix4(-rhs[0], -rhs[1], -rhs[2], -rhs[3], -rhs[4], -rhs[5], -rhs[6], -rhs[7], -rhs[8], -rhs[9], -rhs[10], -rhs[11], -rhs[12], -rhs[13], -rhs[14], -rhs[15]);
+    return Matrix4T<T>(-rhs[0], -rhs[1], -rhs[2], -rhs[3], -rhs[4], -rhs[5], -rhs[6], -rhs[7], -rhs[8], -rhs[9], -rhs[10], -rhs[11], -rhs[12], -rhs[13], -rhs[14], -rhs[15]);
 }
 
 
 
-inline Matrix4 operator*(float s, const Matrix4& rhs)
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T> operator*(T s, const Matrix4T<T>& rhs)
 {
-    return Matrix4(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3], s*rhs[4], s*rhs[5], s*rhs[6], s*rhs[7], s*rhs[8], s*rhs[9], s*rhs[10], s*rhs[11], s*rhs[12], s*rhs[13], s*rhs[14], s*rhs[15]);
+    return Matrix4T<T>(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3], s*rhs[4], s*rhs[5], s*rhs[6], s*rhs[7], s*rhs[8], s*rhs[9], s*rhs[10], s*rhs[11], s*rhs[12], s*rhs[13], s*rhs[14], s*rhs[15]);
 }
 
 
 
-inline Vector4 operator*(const Vector4& v, const Matrix4& m)
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> operator*(const Vector4T<T>& v, const Matrix4T<T>& m)
 {
-    return Vector4(v.x*m[0] + v.y*m[1] + v.z*m[2] + v.w*m[3],  v.x*m[4] + v.y*m[5] + v.z*m[6] + v.w*m[7],  v.x*m[8] + v.y*m[9] + v.z*m[10] + v.w*m[11], v.x*m[12] + v.y*m[13] + v.z*m[14] + v.w*m[15]);
+    return Vector4T<T>(v.x*m[0] + v.y*m[1] + v.z*m[2] + v.w*m[3],  v.x*m[4] + v.y*m[5] + v.z*m[6] + v.w*m[7],  v.x*m[8] + v.y*m[9] + v.z*m[10] + v.w*m[11], v.x*m[12] + v.y*m[13] + v.z*m[14] + v.w*m[15]);
 }
 
 
 
-inline Vector3 operator*(const Vector3& v, const Matrix4& m)
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> operator*(const Vector3T<T>& v, const Matrix4T<T>& m)
 {
-    return Vector3(v.x*m[0] + v.y*m[1] + v.z*m[2],  v.x*m[4] + v.y*m[5] + v.z*m[6],  v.x*m[8] + v.y*m[9] + v.z*m[10]);
+    return Vector3T<T>(v.x*m[0] + v.y*m[1] + v.z*m[2],  v.x*m[4] + v.y*m[5] + v.z*m[6],  v.x*m[8] + v.y*m[9] + v.z*m[10]);
 }
 
 
 
-inline std::ostream& operator<<(std::ostream& os, const Matrix4& m)
+template<typename T>
+inline std::ostream& operator<<(std::ostream& os, const Matrix4T<T>& m)
 {
     os << std::fixed << std::setprecision(5);
     os << "[" << std::setw(10) << m[0] << " " << std::setw(10) << m[4] << " " << std::setw(10) << m[8]  <<  " " << std::setw(10) << m[12] << "]\n"
@@ -922,4 +995,17 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix4& m)
     return os;
 }
 // END OF MATRIX4 INLINE //////////////////////////////////////////////////////
+
+
+
+///////////////////////////////////////////////////////////////////////////
+// aliases for single and double precision
+///////////////////////////////////////////////////////////////////////////
+typedef Matrix2T<float>  Matrix2;
+typedef Matrix3T<float>  Matrix3;
+typedef Matrix4T<float>  Matrix4;
+typedef Matrix2T<double> Matrix2d;
+typedef Matrix3T<double> Matrix3d;
+typedef Matrix4T<double> Matrix4d;
+
 #endif
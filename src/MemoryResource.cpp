@@ -0,0 +1,408 @@
+///////////////////////////////////////////////////////////////////////////////
+// MemoryResource.cpp
+// ==================
+// polymorphic memory resources for the generated geometry
+//
+// Dependencies: none
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include "MemoryResource.h"
+
+#if defined(WIN32) || defined(_WIN32)   // Windows system specific
+#include <windows.h>
+#include <psapi.h>
+#else                                   // Unix based system specific
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace
+{
+///////////////////////////////////////////////////////////////////////////////
+// global new/delete
+// The requests aligned more than max_align_t are served with extra space in
+// front, and the offset to the allocated block is stored just before the
+// returned pointer.
+///////////////////////////////////////////////////////////////////////////////
+class NewDeleteResource : public MemoryResource
+{
+protected:
+    void* doAllocate(std::size_t bytes, std::size_t alignment)
+    {
+        if(alignment <= DEFAULT_ALIGNMENT)
+            return ::operator new(bytes);
+
+        char* block = static_cast<char*>(::operator new(bytes + alignment + sizeof(std::size_t)));
+        uintptr_t address = reinterpret_cast<uintptr_t>(block) + sizeof(std::size_t);
+        address = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        char* ptr = reinterpret_cast<char*>(address);
+        reinterpret_cast<std::size_t*>(ptr)[-1] = ptr - block;
+        return ptr;
+    }
+
+    void doDeallocate(void* ptr, std::size_t, std::size_t alignment)
+    {
+        if(!ptr)
+            return;
+        if(alignment <= DEFAULT_ALIGNMENT)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        char* p = static_cast<char*>(ptr);
+        ::operator delete(p - reinterpret_cast<std::size_t*>(p)[-1]);
+    }
+
+    bool doIsEqual(const MemoryResource& other) const
+    {
+        return dynamic_cast<const NewDeleteResource*>(&other) != 0;
+    }
+};
+}
+
+MemoryResource* getDefaultResource()
+{
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctors/dtor
+///////////////////////////////////////////////////////////////////////////////
+MonotonicArena::MonotonicArena(std::size_t blockSize, MemoryResource* upstream)
+: upstream(upstream ? upstream : getDefaultResource()), blocks(0), current(0), end(0), buffer(0), bufferSize(0),
+  initialBlockSize(blockSize > 0 ? blockSize : 1024), nextBlockSize(initialBlockSize), usedSize(0), reservedSize(0)
+{
+}
+
+MonotonicArena::MonotonicArena(void* buffer, std::size_t size, MemoryResource* upstream)
+: upstream(upstream ? upstream : getDefaultResource()), blocks(0), current(0), end(0),
+  buffer(static_cast<char*>(buffer)), bufferSize(size),
+  initialBlockSize(size > 0 ? size : 1024), nextBlockSize(initialBlockSize), usedSize(0), reservedSize(0)
+{
+    current = this->buffer;
+    end = this->buffer + bufferSize;
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    release();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// free all upstream blocks at once, and start again from the initial buffer
+// All memory given out by this arena becomes invalid.
+///////////////////////////////////////////////////////////////////////////////
+void MonotonicArena::release()
+{
+    while(blocks)
+    {
+        Block* next = blocks->next;
+        upstream->deallocate(blocks, blocks->size, alignof(Block));
+        blocks = next;
+    }
+
+    current = buffer;
+    end = buffer + bufferSize;
+    nextBlockSize = initialBlockSize;
+    usedSize = reservedSize = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take memory from the current block, or add a new block if it is full
+///////////////////////////////////////////////////////////////////////////////
+void* MonotonicArena::doAllocate(std::size_t bytes, std::size_t alignment)
+{
+    if(bytes == 0)
+        bytes = 1;
+
+    uintptr_t address = (reinterpret_cast<uintptr_t>(current) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if(!current || address + bytes > reinterpret_cast<uintptr_t>(end))
+    {
+        // the new block is large enough for this request at least
+        std::size_t size = nextBlockSize;
+        while(size < bytes + alignment + sizeof(Block))
+            size *= 2;
+
+        Block* block = static_cast<Block*>(upstream->allocate(size, alignof(Block)));
+        block->next = blocks;
+        block->size = size;
+        blocks = block;
+        reservedSize += size;
+        nextBlockSize = size * 2;
+
+        current = reinterpret_cast<char*>(block + 1);
+        end = reinterpret_cast<char*>(block) + size;
+        address = (reinterpret_cast<uintptr_t>(current) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    current = reinterpret_cast<char*>(address + bytes);
+    usedSize += bytes;
+    return reinterpret_cast<void*>(address);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// page resource
+///////////////////////////////////////////////////////////////////////////////
+PageResource::PageResource(int flags) : flags(flags), mappedSize(0), mapCount(0)
+{
+}
+
+std::size_t PageResource::getPageSize()
+{
+#if defined(WIN32) || defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return (std::size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+// size of the transparent huge pages (2MB on x86-64), page size if none
+std::size_t PageResource::getHugePageSize()
+{
+#if defined(__linux__)
+    static std::size_t size = 0;
+    if(size == 0)
+    {
+        size = 2 * 1024 * 1024;
+        FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+        if(file)
+        {
+            unsigned long value = 0;
+            if(fscanf(file, "%lu", &value) == 1 && value > 0)
+                size = value;
+            fclose(file);
+        }
+    }
+    return size;
+#else
+    return getPageSize();
+#endif
+}
+
+// size of the pages mapped with MAP_HUGETLB ("Hugepagesize" of /proc/meminfo,
+// 2MB or 1GB on x86-64), the transparent huge page size if none
+std::size_t PageResource::getExplicitHugePageSize()
+{
+#if defined(__linux__)
+    static std::size_t size = 0;
+    if(size == 0)
+    {
+        size = getHugePageSize();
+        FILE* file = fopen("/proc/meminfo", "r");
+        if(file)
+        {
+            char line[256];
+            unsigned long value = 0;
+            while(fgets(line, sizeof(line), file))
+            {
+                if(sscanf(line, "Hugepagesize: %lu kB", &value) == 1 && value > 0)
+                {
+                    size = (std::size_t)value * 1024;
+                    break;
+                }
+            }
+            fclose(file);
+        }
+    }
+    return size;
+#else
+    return getPageSize();
+#endif
+}
+
+// the unit of PAGE_HUGE_EXPLICIT is the one of the pool; an allocation that
+// falls back to transparent huge pages uses getHugePageSize()
+std::size_t PageResource::getGranularity() const
+{
+    if(flags & PAGE_HUGE_EXPLICIT)
+        return getExplicitHugePageSize();
+    if(flags & PAGE_HUGE)
+        return getHugePageSize();
+    return getPageSize();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// map the pages for the request rounded up to the page size
+// The transparent huge pages need the address aligned to the huge page size,
+// so the mapping is made larger, then the unaligned head and tail are unmapped.
+// The explicit huge pages are tried first with the size of the pool pages.
+///////////////////////////////////////////////////////////////////////////////
+void* PageResource::doAllocate(std::size_t bytes, std::size_t alignment)
+{
+    if(bytes == 0)
+        bytes = 1;
+
+    void* ptr = 0;
+    std::size_t size = 0;
+    if(flags & PAGE_HUGE_EXPLICIT)
+    {
+        std::size_t unit = getExplicitHugePageSize();
+        size = (bytes + unit - 1) / unit * unit;
+        ptr = map(size, alignment, true);
+    }
+    if(!ptr)
+    {
+        std::size_t unit = (flags & (PAGE_HUGE | PAGE_HUGE_EXPLICIT)) ? getHugePageSize() : getPageSize();
+        size = (bytes + unit - 1) / unit * unit;
+        if(alignment < unit)
+            alignment = unit;
+        ptr = map(size, alignment, false);
+    }
+    if(!ptr)
+        throw std::bad_alloc();
+
+    mappings[ptr] = size;
+    mappedSize += size;
+    ++mapCount;
+    return ptr;
+}
+
+// unmap with the size it was mapped with
+void PageResource::doDeallocate(void* ptr, std::size_t, std::size_t)
+{
+    std::map<void*, std::size_t>::iterator it = mappings.find(ptr);
+    if(it == mappings.end())
+        return;
+
+    std::size_t size = it->second;
+    mappings.erase(it);
+#if defined(WIN32) || defined(_WIN32)
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+    mappedSize -= size;
+    --mapCount;
+}
+
+// return 0 if failed
+void* PageResource::map(std::size_t size, std::size_t alignment, bool explicitHuge)
+{
+#if defined(WIN32) || defined(_WIN32)
+    (void)alignment;
+    if(explicitHuge)
+        return 0;               // large pages need a privilege, use normal pages
+    return VirtualAlloc(0, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    int mapFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+    if(flags & PAGE_POPULATE)
+        mapFlags |= MAP_POPULATE;
+#endif
+
+    if(explicitHuge)
+    {
+#if defined(MAP_HUGETLB)
+        // aligned by the kernel, fails if the pool has not enough pages
+        void* ptr = mmap(0, size, PROT_READ | PROT_WRITE, mapFlags | MAP_HUGETLB, -1, 0);
+        return (ptr == MAP_FAILED) ? 0 : ptr;
+#else
+        return 0;
+#endif
+    }
+
+    // reserve extra space for the alignment without populating it
+    std::size_t extra = (alignment > getPageSize()) ? alignment : 0;
+    char* base = static_cast<char*>(mmap(0, size + extra, PROT_READ | PROT_WRITE,
+                                         (extra > 0 ? MAP_PRIVATE | MAP_ANONYMOUS : mapFlags), -1, 0));
+    if(base == MAP_FAILED)
+        return 0;
+
+    char* ptr = base;
+    if(extra > 0)
+    {
+        uintptr_t address = (reinterpret_cast<uintptr_t>(base) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        ptr = reinterpret_cast<char*>(address);
+        if(ptr > base)
+            munmap(base, ptr - base);
+        if(ptr + size < base + size + extra)
+            munmap(ptr + size, (base + size + extra) - (ptr + size));
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if(flags & (PAGE_HUGE | PAGE_HUGE_EXPLICIT))
+        madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+
+    // MAP_POPULATE was skipped for the oversized mapping, touch the pages now
+    if(extra > 0 && (flags & PAGE_POPULATE))
+    {
+        std::size_t step = getPageSize();
+        for(std::size_t i = 0; i < size; i += step)
+            ptr[i] = 0;
+    }
+    return ptr;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read page faults and TLB misses of this process
+///////////////////////////////////////////////////////////////////////////////
+void readMemoryCounters(MemoryCounters& counters)
+{
+    counters.minorFaults = counters.majorFaults = counters.tlbMisses = -1;
+
+#if defined(WIN32) || defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS info;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info)))
+        counters.minorFaults = info.PageFaultCount;     // soft and hard faults together
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        counters.minorFaults = usage.ru_minflt;
+        counters.majorFaults = usage.ru_majflt;
+    }
+#endif
+
+#if defined(__linux__)
+    // the counter is opened at the first call, and counts from then on
+    static int tlbFd = -2;
+    if(tlbFd == -2)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        tlbFd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if(tlbFd < 0)
+            tlbFd = -1;
+    }
+
+    long long value = 0;
+    if(tlbFd >= 0 && read(tlbFd, &value, sizeof(value)) == (ssize_t)sizeof(value))
+        counters.tlbMisses = value;
+#endif
+}
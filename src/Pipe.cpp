@@ -3,14 +3,16 @@
 // ========
 // base contour following a path
 //
-// Dependencies: Vector3, Plane, Line, Matrix4
+// Dependencies: Vector3, Plane, Line, Matrix4, Quaternion, Kernels, MemoryResource,
+//               ProfileRegistry
 //
 //  AUTHOR: Song ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-04-16
-// UPDATED: 2020-04-22
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Pipe.h"
+#include "Kernels.h"
 #include "Matrices.h"
 #include "Line.h"
 #include "Plane.h"
@@ -21,11 +23,18 @@
 ///////////////////////////////////////////////////////////////////////////////
 // ctors
 ///////////////////////////////////////////////////////////////////////////////
-Pipe::Pipe()
+template<typename T>
+PipeT<T>::PipeT(MemoryResource* resource) : layers(1), sweep(PIPE_SWEEP_PROJECT), normalMode(PIPE_NORMAL_RADIAL), attributes(PIPE_ATTRIB_NORMAL),
+  checkpointInterval(0), pendingIndex(-1), rollIndex(-1), dirtyFirst(0), dirtyLast(-1), windowSize(0), firstIndex(0),
+  resource(resource ? resource : getDefaultResource())
 {
 }
 
-Pipe::Pipe(const std::vector<Vector3>& pathPoints, const std::vector<Vector3>& contourPoints)
+template<typename T>
+PipeT<T>::PipeT(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints,
+                MemoryResource* resource)
+: layers(1), sweep(PIPE_SWEEP_PROJECT), normalMode(PIPE_NORMAL_RADIAL), attributes(PIPE_ATTRIB_NORMAL),
+  checkpointInterval(0), pendingIndex(-1), rollIndex(-1), dirtyFirst(0), dirtyLast(-1), windowSize(0), firstIndex(0), resource(resource ? resource : getDefaultResource())
 {
     set(pathPoints, contourPoints);
 }
@@ -35,61 +44,547 @@ Pipe::Pipe(const std::vector<Vector3>& pathPoints, const std::vector<Vector3>& c
 ///////////////////////////////////////////////////////////////////////////////
 // setters
 ///////////////////////////////////////////////////////////////////////////////
-void Pipe::set(const std::vector<Vector3>& pathPoints, const std::vector<Vector3>& contourPoints)
+template<typename T>
+void PipeT<T>::set(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints)
 {
-    this->path = pathPoints;
-    this->contour = contourPoints;
+    set(pathPoints, ProfileRegistryT<T>::getInstance().getProfile(contourPoints));
+}
+
+template<typename T>
+void PipeT<T>::set(const std::vector< Vector3T<T> >& pathPoints, const ProfilePtr& profile)
+{
+    this->path.assign(pathPoints.begin(), pathPoints.end());
+    this->layers[0].profile = profile;
+    this->firstIndex = 0;
+    updateJoints(0, (int)path.size() - 1);
+    generateContours();
+    if(windowSize > 0 && (int)path.size() > windowSize)
+        evictPathPoints((int)path.size() - windowSize);
+}
+
+template<typename T>
+void PipeT<T>::setPath(const std::vector< Vector3T<T> >& pathPoints)
+{
+    this->path.assign(pathPoints.begin(), pathPoints.end());
+    this->firstIndex = 0;
+    updateJoints(0, (int)path.size() - 1);
+    generateContours();
+    if(windowSize > 0 && (int)path.size() > windowSize)
+        evictPathPoints((int)path.size() - windowSize);
+}
+
+template<typename T>
+void PipeT<T>::setContour(const std::vector< Vector3T<T> >& contourPoints)
+{
+    setProfile(ProfileRegistryT<T>::getInstance().getProfile(contourPoints));
+}
+
+template<typename T>
+void PipeT<T>::setProfile(const ProfilePtr& profile)
+{
+    this->layers[0].profile = profile;
+    generateContours();
+}
+
+// return the points of the profile, empty if there is no profile
+template<typename T>
+const std::vector< Vector3T<T> >& PipeT<T>::getBaseContour() const
+{
+    return getPoints(layers[0]);
+}
+
+template<typename T>
+const std::vector< Vector3T<T> >& PipeT<T>::getPoints(const Layer& layer)
+{
+    static const std::vector< Vector3T<T> > empty;
+    return layer.profile ? layer.profile->getPoints() : empty;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a profile swept with the main one, and return the index of the layer
+// The rings of the new layer are generated for the current path.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PipeT<T>::addLayer(const std::vector< Vector3T<T> >& contourPoints, bool inward)
+{
+    return addLayer(ProfileRegistryT<T>::getInstance().getProfile(contourPoints), inward);
+}
+
+template<typename T>
+int PipeT<T>::addLayer(const ProfilePtr& profile, bool inward)
+{
+    layers.push_back(Layer(profile, inward));
     generateContours();
+    return (int)layers.size() - 1;
 }
 
-void Pipe::setPath(const std::vector<Vector3>& pathPoints)
+template<typename T>
+void PipeT<T>::removeLayers()
 {
-    this->path = pathPoints;
+    if(layers.size() > 1)
+        layers.erase(layers.begin() + 1, layers.end());
+}
+
+template<typename T>
+void PipeT<T>::setSweep(PipeSweep sweep)
+{
+    if(this->sweep == sweep)
+        return;
+
+    this->sweep = sweep;
     generateContours();
 }
 
-void Pipe::setContour(const std::vector<Vector3>& contourPoints)
+template<typename T>
+void PipeT<T>::setNormalMode(PipeNormal mode)
 {
-    this->contour = contourPoints;
+    if(this->normalMode == mode)
+        return;
+
+    this->normalMode = mode;
     generateContours();
 }
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// select the optional attributes to compute (PipeAttribute flags)
+// Only the changed channels are computed or dropped; the contours are kept.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::setAttributes(int attributes)
+{
+    int changed = this->attributes ^ attributes;
+    this->attributes = attributes;
+    if(!changed)
+        return;
+
+    int count = (int)path.size();
+    if(changed & (PIPE_ATTRIB_TEXCOORD | PIPE_ATTRIB_TANGENT))
+        updateChannels(0, count - 1);
+
+    if(changed & PIPE_ATTRIB_NORMAL)
+    {
+        for(std::size_t k = 0; k < layers.size(); ++k)
+        {
+            Layer& layer = layers[k];
+            for(int i = 0; i < count; ++i)
+            {
+                if(layer.contours[i].empty())
+                    layer.normals[i].clear();   // released, rebuilt with the contour
+                else
+                    computeContourNormal(layer, layer.contours[i], i, layer.normals[i]);
+            }
+        }
+    }
+
+    if(count > 0)
+    {
+        dirtyFirst = 0;
+        dirtyLast = count - 1;
+    }
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // add a new path point at the end of the path list
 ///////////////////////////////////////////////////////////////////////////////
-void Pipe::addPathPoint(const Vector3& point)
+template<typename T>
+void PipeT<T>::addPathPoint(const Vector3T<T>& point)
 {
     // add it to path first
     path.push_back(point);
 
+    // the new point changes the joint of the previous point as well, so
+    // update the contours of the last 2 points
+    // (the first contour is kept in PIPE_SWEEP_PROJECT)
     int count = path.size();
-    if(count == 1)
+    updateJoints(count - 2, count - 1);
+    resizeContours(count);
+
+    int first = count - 2;
+    if(first < 0 || (first == 0 && sweep == PIPE_SWEEP_PROJECT))
+        first = count - 1;
+    for(int i = first; i < count; ++i)
+        sweepContour(i);
+
+    // drop the oldest point if the window is full
+    if(windowSize > 0 && count > windowSize)
+        evictPathPoints(count - windowSize);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove the path points after the first count points
+// The storage of the removed contours is kept to reuse for the next points.
+// Only the contour at the new last point is recomputed, because its joint
+// plane (or frame) is now perpendicular to the last segment. The first
+// contour is kept as is in PIPE_SWEEP_PROJECT, so truncate(1) rewinds the
+// pipe to the first point without transforming the contour again.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::truncate(int count)
+{
+    if(count < 0)
+        count = 0;
+    if(count >= (int)path.size())
+        return;
+
+    path.resize(count);
+    updateJoints(count - 1, count - 1);
+    resizeContours(count);
+
+    if(pendingIndex >= count)
+        pendingIndex = -1;
+    if(rollIndex >= count)
+    {
+        rollIndex = -1;
+        pendingRoll = QuaternionT<T>();
+    }
+
+    if(count > 1 || (count == 1 && sweep == PIPE_SWEEP_FRAME))
+    {
+        sweepContour(count - 1);
+        if(pendingIndex == count - 1)
+            pendingIndex = -1;
+    }
+}
+
+template<typename T>
+void PipeT<T>::popPathPoint()
+{
+    if(!path.empty())
+        truncate((int)path.size() - 1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all path points, and free the storage of the contours including the
+// spare lists (the base contour and the settings are kept)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::clear()
+{
+    path.clear();
+    for(std::size_t k = 0; k < layers.size(); ++k)
+    {
+        layers[k].contours.clear();
+        layers[k].normals.clear();
+        std::vector<Contour>().swap(layers[k].spareContours);
+        std::vector<Contour>().swap(layers[k].spareNormals);
+    }
+    frames.clear();
+    directions.clear();
+    planes.clear();
+    arcLengths.clear();
+    tangents.clear();
+    firstIndex = 0;
+    pendingIndex = -1;
+    rollIndex = -1;
+    pendingRoll = QuaternionT<T>();
+    clearDirtyRange();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate the contours from another memory resource (0 for the heap)
+// The existing contours are freed to the old resource, then generated again.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::setMemoryResource(MemoryResource* resource)
+{
+    if(!resource)
+        resource = getDefaultResource();
+    if(this->resource == resource)
+        return;
+
+    for(std::size_t k = 0; k < layers.size(); ++k)
+    {
+        layers[k].contours.clear();
+        layers[k].normals.clear();
+        std::vector<Contour>().swap(layers[k].spareContours);
+        std::vector<Contour>().swap(layers[k].spareNormals);
+    }
+    this->resource = resource;
+    generateContours();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sliding window of the last size path points (0 = no limit)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::setWindowSize(int size)
+{
+    windowSize = (size > 0) ? size : 0;
+    if(windowSize > 0 && (int)path.size() > windowSize)
+        evictPathPoints((int)path.size() - windowSize);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove the oldest path points and their contours, O(1) per point
+// The contour storage goes to the spare list to be reused by the new points.
+// The next contour becomes the first one, which must be kept as the start
+// of the projection (and of reconstruction in keyframed mode).
+// The joint table is popped with the points, so the entry of the new first
+// point keeps the evicted segment and the bisecting plane of its joint: the
+// first ring lies on that plane (and faces that tangent), and the tangent of
+// the next frame is propagated from it. It is not reset to the first segment
+// as on a new path until one of the first 2 points is moved.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::evictPathPoints(int count)
+{
+    if(count > (int)path.size())
+        count = (int)path.size();
+
+    for(int n = 0; n < count; ++n)
     {
-        transformFirstContour();
-        normals.push_back(computeContourNormal(0));
+        for(std::size_t k = 0; k < layers.size(); ++k)
+        {
+            Layer& layer = layers[k];
+            if(sweep == PIPE_SWEEP_PROJECT && path.size() > 1 && layer.contours[1].empty() && !getPoints(layer).empty())
+            {
+                projectContour(layer.contours[0], 1, layer.contours[1]);
+                computeContourNormal(layer, layer.contours[1], 1, layer.normals[1]);
+            }
+
+            layer.spareContours.push_back(Contour(resource));
+            layer.spareContours.back().swap(layer.contours.front());
+            layer.contours.pop_front();
+            layer.spareNormals.push_back(Contour(resource));
+            layer.spareNormals.back().swap(layer.normals.front());
+            layer.normals.pop_front();
+        }
+
+        path.pop_front();
+        directions.pop_front();
+        planes.pop_front();
+        if(!arcLengths.empty())
+            arcLengths.pop_front();
+        if(!tangents.empty())
+            tangents.pop_front();
+        if(!frames.empty())
+            frames.pop_front();
+        ++firstIndex;
+    }
+
+    // shift the indices of pending and dirty contours
+    if(pendingIndex > 0)
+        pendingIndex = (pendingIndex > count) ? pendingIndex - count : 0;
+    if(rollIndex > 0)
+        rollIndex = (rollIndex > count) ? rollIndex - count : 0;
+    if(dirtyFirst <= dirtyLast)
+    {
+        dirtyFirst = (dirtyFirst > count) ? dirtyFirst - count : 0;
+        dirtyLast -= count;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// edit path points in place
+// The joints next to the moved points are updated right away, and the
+// contours after them are marked pending and recomputed on demand by
+// sweepPending(). Until then, the pending contours keep their old shape.
+// For PIPE_SWEEP_PROJECT, every contour after the moved points depends on
+// the previous one, so they are projected again.
+// For PIPE_SWEEP_FRAME, the contours in the neighbourhood are recomputed
+// right away. The tangents after it are not changed, so each new frame there
+// is the old one rolled about its tangent by the same rotation; it is
+// computed once at the next contour and applied to the pending frames by
+// sweepPending(), which gives the same frames as a fresh sweep.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::setPathPoint(int index, const Vector3T<T>& point)
+{
+    if(index < 0 || index >= (int)path.size())
+        return;
+
+    path[index] = point;
+    updatePathRange(index, index);
+}
+
+template<typename T>
+void PipeT<T>::movePathPoints(int first, int count, const Vector3T<T>& offset)
+{
+    int pathCount = (int)path.size();
+    if(first < 0)
+    {
+        count += first;
+        first = 0;
+    }
+    if(first + count > pathCount)
+        count = pathCount - first;
+    if(count <= 0)
+        return;
+
+    for(int i = first; i < first + count; ++i)
+        path[i] += offset;
+    updatePathRange(first, first + count - 1);
+}
+
+template<typename T>
+void PipeT<T>::updatePathRange(int first, int last)
+{
+    // a moved point changes the segments on both sides of it
+    int count = (int)path.size();
+    updateJoints(first - 1, last + 1);
+
+    int firstContour = (first > 0) ? first - 1 : 0;
+    int lastContour = (last + 1 < count) ? last + 1 : count - 1;
+    if(sweep == PIPE_SWEEP_FRAME)
+    {
+        // the frames before the next contour must be up to date to propagate
+        // the neighbourhood from them
+        int next = lastContour + 1;
+        moveRollIndex(next);
+        for(int i = firstContour; i <= lastContour; ++i)
+            sweepContour(i);
+        releaseContour(lastContour);
+
+        // roll from the stored frame to the new one (including the roll
+        // still pending from the previous edits)
+        if(next < count)
+        {
+            QuaternionT<T> inverse = frames[next];
+            pendingRoll = inverse.conjugate() * computeFrame(next);
+            rollIndex = next;
+            if(pendingIndex < 0 || next < pendingIndex)
+                pendingIndex = next;
+        }
+    }
+    else if(pendingIndex < 0 || firstContour < pendingIndex)
+    {
+        pendingIndex = firstContour;
     }
-    else if(count == 2)
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// apply the pending roll to the frames before the index, or take it back
+// from the frames after the index, so that the frames before the index are
+// up to date and all frames after it miss the same roll
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::moveRollIndex(int index)
+{
+    if(rollIndex < 0)
+        return;
+
+    int count = (int)frames.size();
+    if(index > count)
+        index = count;
+
+    if(index > rollIndex)
     {
-        contours.push_back(projectContour(0, 1));
-        normals.push_back(computeContourNormal(1));
+        for(int i = rollIndex; i < index; ++i)
+            frames[i] = frames[i] * pendingRoll;
     }
     else
     {
-        // add dummy to match same # of contours/normals and path
-        std::vector<Vector3> dummy;
-        contours.push_back(dummy);
-        normals.push_back(dummy);
+        QuaternionT<T> inverse = pendingRoll;
+        inverse.conjugate();
+        for(int i = index; i < rollIndex; ++i)
+            frames[i] = frames[i] * inverse;
+    }
+
+    rollIndex = index;
+    if(rollIndex >= count)
+    {
+        rollIndex = -1;
+        pendingRoll = QuaternionT<T>();
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// recompute at most maxCount pending contours (all if maxCount < 0) after
+// the path points are edited, and return the number of contours still
+// pending. It can be called in small steps (e.g. once per frame) and
+// stopped at any time; a new edit before the end restarts it from the
+// first pending contour.
+// For PIPE_SWEEP_FRAME, the pending frames are rolled instead of propagated
+// again.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PipeT<T>::sweepPending(int maxCount)
+{
+    int count = (int)path.size();
+    if(pendingIndex < 0)
+        return 0;
 
-        // re-project the previous contour
-        contours[count-2] = projectContour(count-3, count-2);
-        normals[count-2] = computeContourNormal(count-2);
+    int last = count;
+    if(maxCount >= 0 && pendingIndex + maxCount < count)
+        last = pendingIndex + maxCount;
 
-        // compute for new contour
-        contours[count-1] = projectContour(count-2, count-1);
-        normals[count-1] = computeContourNormal(count-1);
+    for(int i = pendingIndex; i < last; ++i)
+    {
+        if(sweep == PIPE_SWEEP_FRAME)
+        {
+            if(rollIndex >= 0 && i >= rollIndex)
+                moveRollIndex(i + 1);
+            sweepLayers(i);
+        }
+        else
+        {
+            sweepContour(i);
+        }
     }
+
+    pendingIndex = (last < count) ? last : -1;
+    return count - last;
+}
+
+template<typename T>
+int PipeT<T>::getPendingCount() const
+{
+    return (pendingIndex < 0) ? 0 : (int)path.size() - pendingIndex;
+}
+
+// drop the pending contours; they keep their old shape (and frames)
+template<typename T>
+void PipeT<T>::cancelPending()
+{
+    pendingIndex = -1;
+    rollIndex = -1;
+    pendingRoll = QuaternionT<T>();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// range of contours recomputed since the last clearDirtyRange()
+// Renderers and exporters update only this slice of the pipe.
+// return false if no contour is changed
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+bool PipeT<T>::getDirtyRange(int& first, int& last) const
+{
+    first = dirtyFirst;
+    last = dirtyLast;
+    if(last > (int)path.size() - 1)
+        last = (int)path.size() - 1;
+    return first <= last;
+}
+
+template<typename T>
+void PipeT<T>::clearDirtyRange()
+{
+    dirtyFirst = 0;
+    dirtyLast = -1;
 }
 
 
@@ -97,109 +592,770 @@ void Pipe::addPathPoint(const Vector3& point)
 ///////////////////////////////////////////////////////////////////////////////
 // build countour vertex and normal list on each path point
 ///////////////////////////////////////////////////////////////////////////////
-void Pipe::generateContours()
+template<typename T>
+void PipeT<T>::generateContours()
+{
+    // reuse the storage of the existing contours
+    int count = (int)path.size();
+    resizeContours(count);
+    pendingIndex = -1;
+    rollIndex = -1;
+    pendingRoll = QuaternionT<T>();
+
+    // rotate and translate the contour to the first path point, then project
+    // it to the plane at the next path point (or rotate it with the frame)
+    for(int i = 0; i < count; ++i)
+        sweepContour(i);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute the contours and normals of all layers at the path point from the
+// previous ones
+// The joint (direction and plane) and the frame are computed once, and
+// shared by the layers.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::sweepContour(int pathIndex)
+{
+    if(hasFrames())
+    {
+        frames[pathIndex] = computeFrame(pathIndex);
+
+        // propagated from an up-to-date frame, so it misses no roll
+        if(pathIndex == rollIndex)
+        {
+            ++rollIndex;
+            if(rollIndex >= (int)path.size())
+            {
+                rollIndex = -1;
+                pendingRoll = QuaternionT<T>();
+            }
+        }
+    }
+    sweepLayers(pathIndex);
+}
+
+// with the frame at the path point already computed
+template<typename T>
+void PipeT<T>::sweepLayers(int pathIndex)
+{
+    for(std::size_t k = 0; k < layers.size(); ++k)
+    {
+        Layer& layer = layers[k];
+        if(sweep == PIPE_SWEEP_FRAME)
+        {
+            rotateContour(layer, pathIndex, layer.contours[pathIndex]);
+        }
+        else if(pathIndex == 0)
+        {
+            transformFirstContour(layer, layer.contours[0]);
+        }
+        else
+        {
+            // the previous contour may be released in keyframed mode
+            if(layer.contours[pathIndex - 1].empty() && !getPoints(layer).empty())
+                restoreContour(layer, pathIndex - 1);
+            projectContour(layer.contours[pathIndex - 1], pathIndex, layer.contours[pathIndex]);
+        }
+        computeContourNormal(layer, layer.contours[pathIndex], pathIndex, layer.normals[pathIndex]);
+    }
+    releaseContour(pathIndex - 1);
+
+    // expand dirty range
+    if(dirtyFirst > dirtyLast)
+    {
+        dirtyFirst = dirtyLast = pathIndex;
+    }
+    else
+    {
+        if(pathIndex < dirtyFirst) dirtyFirst = pathIndex;
+        if(pathIndex > dirtyLast)  dirtyLast = pathIndex;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// keyframed storage
+// With interval K > 0, only the contours at every K-th path point (the
+// checkpoints), the first one and the last 2 (needed to append) are kept. The
+// others are released after use, and reconstructed on demand from the
+// nearest checkpoint before it, which costs at most K-1 projections.
+// PIPE_SWEEP_FRAME keeps the frame of every point instead, so any contour is
+// rebuilt directly from its frame.
+// Setting K to 0 restores and keeps all contours again.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::setCheckpointInterval(int interval)
+{
+    if(interval < 0)
+        interval = 0;
+    if(interval == checkpointInterval)
+        return;
+
+    // restore all contours from the current checkpoints first
+    int count = (int)path.size();
+    for(std::size_t k = 0; k < layers.size(); ++k)
+    {
+        Layer& layer = layers[k];
+        for(int i = 1; i < count; ++i)
+        {
+            if(!layer.contours[i].empty() || getPoints(layer).empty())
+                continue;
+
+            if(sweep == PIPE_SWEEP_FRAME)
+                rotateContour(layer, i, layer.contours[i]);
+            else
+                projectContour(layer.contours[i-1], i, layer.contours[i]);
+            computeContourNormal(layer, layer.contours[i], i, layer.normals[i]);
+        }
+    }
+
+    // then release them with the new interval
+    checkpointInterval = interval;
+    for(int i = 0; i < count; ++i)
+        releaseContour(i);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy (or reconstruct) the contours and normals of path points
+// [first, first+count) to the lists; works with and without checkpoints
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::copyContours(int first, int count,
+                            std::vector<Contour>& dstContours,
+                            std::vector<Contour>& dstNormals) const
+{
+    copyLayerContours(0, first, count, dstContours, dstNormals);
+}
+
+template<typename T>
+void PipeT<T>::copyLayerContours(int layerIndex, int first, int count,
+                                 std::vector<Contour>& dstContours,
+                                 std::vector<Contour>& dstNormals) const
+{
+    const Layer& layer = layers.at(layerIndex);
+    const BlockList<Contour>& contours = layer.contours;
+    const BlockList<Contour>& normals = layer.normals;
+    int pathCount = (int)path.size();
+    if(first < 0)
+    {
+        count += first;
+        first = 0;
+    }
+    if(first + count > pathCount)
+        count = pathCount - first;
+    if(count < 0)
+        count = 0;
+
+    dstContours.resize(count);
+    dstNormals.resize(count);
+    Contour buffer;                 // temporary, from the heap
+    for(int i = 0; i < count; ++i)
+    {
+        int index = first + i;
+        if(!contours[index].empty())
+        {
+            // keep the allocator of the destination
+            dstContours[i].assign(contours[index].begin(), contours[index].end());
+            dstNormals[i].assign(normals[index].begin(), normals[index].end());
+            continue;
+        }
+
+        // the previous one in the list is the starting point of projection
+        if(sweep == PIPE_SWEEP_FRAME)
+            rotateContour(layer, index, dstContours[i]);
+        else if(i == 0)
+            reconstructContour(layer, index, dstContours[i], buffer);
+        else
+            projectContour(dstContours[i-1], index, dstContours[i]);
+        computeContourNormal(layer, dstContours[i], index, dstNormals[i]);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the vertices of the contour at the path point with the selected
+// attributes interleaved in this order (getVertexSize() floats per vertex):
+// position(3), normal(3), texcoord(2), tangent(3), ring id(1)
+// return the number of vertices written, 0 if the contour is released (with
+// checkpoints, write the contours of copyLayerContours() instead)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PipeT<T>::getVertexSize() const
+{
+    int size = 3;
+    if(attributes & PIPE_ATTRIB_NORMAL)   size += 3;
+    if(attributes & PIPE_ATTRIB_TEXCOORD) size += 2;
+    if(attributes & PIPE_ATTRIB_TANGENT)  size += 3;
+    if(attributes & PIPE_ATTRIB_RING_ID)  size += 1;
+    return size;
+}
+
+template<typename T>
+int PipeT<T>::writeVertices(int index, float* dst) const
+{
+    return writeVertices(0, index, dst);
+}
+
+template<typename T>
+int PipeT<T>::writeVertices(int layerIndex, int index, float* dst) const
+{
+    const ProfilePtr& profile = layers.at(layerIndex).profile;
+    const Contour& vertices = layers[layerIndex].contours.at(index);
+    const Contour& vertexNormals = layers[layerIndex].normals.at(index);
+    int count = (int)vertices.size();
+    if(count == 0)
+        return 0;
+
+    bool hasNormal = (attributes & PIPE_ATTRIB_NORMAL) && (int)vertexNormals.size() == count;
+    bool hasTexCoord = (attributes & PIPE_ATTRIB_TEXCOORD) != 0;
+    bool hasTexCoordU = hasTexCoord && profile && profile->getCount() == count;
+    for(int i = 0; i < count; ++i)
+    {
+        *dst++ = (float)vertices[i].x;
+        *dst++ = (float)vertices[i].y;
+        *dst++ = (float)vertices[i].z;
+        if(attributes & PIPE_ATTRIB_NORMAL)
+        {
+            Vector3T<T> n = hasNormal ? vertexNormals[i] : Vector3T<T>(0, 0, 0);
+            *dst++ = (float)n.x;
+            *dst++ = (float)n.y;
+            *dst++ = (float)n.z;
+        }
+        if(hasTexCoord)
+        {
+            *dst++ = hasTexCoordU ? (float)profile->getTexCoords()[i] : 0.0f;
+            *dst++ = (float)arcLengths[index];
+        }
+        if(attributes & PIPE_ATTRIB_TANGENT)
+        {
+            *dst++ = (float)tangents[index].x;
+            *dst++ = (float)tangents[index].y;
+            *dst++ = (float)tangents[index].z;
+        }
+        if(attributes & PIPE_ATTRIB_RING_ID)
+            *dst++ = (float)(firstIndex + index);
+    }
+    return count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the end cap between the rings of the layer and the next layer at the
+// first path point (end = false) or at the last one (end = true)
+// The annulus is triangulated by walking both rings in the order of their
+// texture coordinates (normalized length along the profile), so the layers
+// may have different vertex counts. It writes interleaved triangles
+// (GL_N3F_V3F) facing outward from the pipe, and returns the vertex count.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PipeT<T>::buildCap(int layer, bool end, std::vector<float>& dst) const
+{
+    dst.clear();
+    int pathCount = (int)path.size();
+    if(layer < 0 || layer + 1 >= (int)layers.size() || pathCount == 0)
+        return 0;
+
+    // the first and last rings are never released
+    int index = end ? pathCount - 1 : 0;
+    const Contour& ring1 = layers[layer].contours[index];
+    const Contour& ring2 = layers[layer + 1].contours[index];
+    int count1 = (int)ring1.size();
+    int count2 = (int)ring2.size();
+    if(count1 < 2 || count2 < 2)
+        return 0;
+
+    // normal of the plane of the outer ring (Newell's method), so it matches
+    // the ring in every mode: the joint plane, the bisecting plane of the
+    // evicted joint in a sliding window, the tangent plane of a frame, or
+    // +Z for a first ring kept from a single point path
+    Vector3T<T> normal(0, 0, 0);
+    for(int i = 0; i < count1; ++i)
+    {
+        const Vector3T<T>& v1 = ring1[i];
+        const Vector3T<T>& v2 = ring1[(i + 1) % count1];
+        normal.x += (v1.y - v2.y) * (v1.z + v2.z);
+        normal.y += (v1.z - v2.z) * (v1.x + v2.x);
+        normal.z += (v1.x - v2.x) * (v1.y + v2.y);
+    }
+
+    // face it along the path at the last point, against it at the first one;
+    // fall back to the joint plane if the ring is a straight line
+    const Vector3T<T>& jointNormal = planes[index].getNormal();
+    if(normal.dot(normal) <= 0)
+        normal = jointNormal;
+    else if(normal.dot(jointNormal) < 0)
+        normal = -normal;
+    normal.normalize();
+    if(!end)
+        normal = -normal;
+
+    const ProfilePtr& profile1 = layers[layer].profile;
+    const ProfilePtr& profile2 = layers[layer + 1].profile;
+    bool hasU1 = profile1 && profile1->getCount() == count1;
+    bool hasU2 = profile2 && profile2->getCount() == count2;
+
+    dst.reserve((count1 + count2 - 2) * 3 * 6);
+    int i = 0, j = 0;
+    while(i < count1 - 1 || j < count2 - 1)
+    {
+        // advance on the ring with the nearer next point
+        bool next1;
+        if(i == count1 - 1)
+        {
+            next1 = false;
+        }
+        else if(j == count2 - 1)
+        {
+            next1 = true;
+        }
+        else
+        {
+            T u1 = hasU1 ? profile1->getTexCoords()[i + 1] : T(i + 1) / (count1 - 1);
+            T u2 = hasU2 ? profile2->getTexCoords()[j + 1] : T(j + 1) / (count2 - 1);
+            next1 = (u1 <= u2);
+        }
+
+        const Vector3T<T>* v[3];
+        v[0] = &ring1[i];
+        v[1] = next1 ? &ring1[i + 1] : &ring2[j + 1];
+        v[2] = &ring2[j];
+        if(next1) ++i;
+        else      ++j;
+
+        // wind counter-clockwise around the cap normal
+        if((*v[1] - *v[0]).cross(*v[2] - *v[0]).dot(normal) < 0)
+        {
+            const Vector3T<T>* tmp = v[1];
+            v[1] = v[2];
+            v[2] = tmp;
+        }
+
+        for(int k = 0; k < 3; ++k)
+        {
+            dst.push_back((float)normal.x);
+            dst.push_back((float)normal.y);
+            dst.push_back((float)normal.z);
+            dst.push_back((float)v[k]->x);
+            dst.push_back((float)v[k]->y);
+            dst.push_back((float)v[k]->z);
+        }
+    }
+    return (int)dst.size() / 6;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// reconstruct a released contour from the nearest kept contour before it
+// The projections go back and forth between dst and buffer, so the
+// intermediate contours are not stored.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::reconstructContour(const Layer& layer, int pathIndex, Contour& dst,
+                                  Contour& buffer) const
+{
+    if(sweep == PIPE_SWEEP_FRAME)
+    {
+        rotateContour(layer, pathIndex, dst);
+        return;
+    }
+
+    const BlockList<Contour>& contours = layer.contours;
+    int from = pathIndex;
+    while(from > 0 && contours[from].empty())
+        --from;
+
+    if(from == pathIndex)
+    {
+        dst.assign(contours[pathIndex].begin(), contours[pathIndex].end());
+        return;
+    }
+
+    // the last projection must be written to dst
+    const Contour* prev = &contours[from];
+    for(int i = from + 1; i <= pathIndex; ++i)
+    {
+        Contour& next = ((pathIndex - i) % 2 == 0) ? dst : buffer;
+        projectContour(*prev, i, next);
+        prev = &next;
+    }
+}
+
+// reconstruct the contour and normals in place
+template<typename T>
+void PipeT<T>::restoreContour(Layer& layer, int pathIndex)
 {
-    // reset
-    contours.clear();
-    normals.clear();
+    Contour buffer;                 // temporary, from the heap
+    reconstructContour(layer, pathIndex, layer.contours[pathIndex], buffer);
+    computeContourNormal(layer, layer.contours[pathIndex], pathIndex, layer.normals[pathIndex]);
+}
 
-    // path must have at least a point
-    if(path.size() < 1)
+// release the contours and normals of all layers if it is not a checkpoint
+// nor the last 2
+template<typename T>
+void PipeT<T>::releaseContour(int pathIndex)
+{
+    if(checkpointInterval <= 0 || pathIndex <= 0 || pathIndex >= (int)path.size() - 2)
+        return;
+    if((firstIndex + pathIndex) % checkpointInterval == 0)
         return;
 
-    // rotate and translate the contour to the first path point
-    transformFirstContour();
-    contours.push_back(this->contour);
-    normals.push_back(computeContourNormal(0));
+    for(std::size_t k = 0; k < layers.size(); ++k)
+    {
+        Contour(resource).swap(layers[k].contours[pathIndex]);
+        Contour(resource).swap(layers[k].normals[pathIndex]);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// resize the contour and normal lists to the number of path points
+// The removed lists are moved (swapped) to the spare lists, and the new ones
+// take their storage back, so rewinding and extending the path does not
+// allocate memory again.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::resizeContours(int count)
+{
+    for(std::size_t k = 0; k < layers.size(); ++k)
+    {
+        Layer& layer = layers[k];
+        while((int)layer.contours.size() > count)
+        {
+            layer.spareContours.push_back(Contour(resource));
+            layer.spareContours.back().swap(layer.contours.back());
+            layer.contours.pop_back();
+
+            layer.spareNormals.push_back(Contour(resource));
+            layer.spareNormals.back().swap(layer.normals.back());
+            layer.normals.pop_back();
+        }
+
+        while((int)layer.contours.size() < count)
+        {
+            layer.contours.push_back(Contour(resource));
+            if(!layer.spareContours.empty())
+            {
+                layer.contours.back().swap(layer.spareContours.back());
+                layer.spareContours.pop_back();
+            }
+
+            layer.normals.push_back(Contour(resource));
+            if(!layer.spareNormals.empty())
+            {
+                layer.normals.back().swap(layer.spareNormals.back());
+                layer.spareNormals.pop_back();
+            }
+        }
+    }
+
+    // frames are used by PIPE_SWEEP_FRAME or PIPE_NORMAL_PROFILE only
+    if(hasFrames())
+        frames.resize(count);
+    else
+        frames.clear();
+}
+
+
 
-    // project contour to the plane at the next path point
+///////////////////////////////////////////////////////////////////////////////
+// update the segment directions and the planes of the joints in [first, last]
+// A direction depends on the previous path point, and a plane depends on the
+// directions of both sides, so the range must cover all joints next to the
+// changed path points.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::updateJoints(int first, int last)
+{
     int count = (int)path.size();
-    for(int i = 1; i < count; ++i)
+    directions.resize(count);
+    planes.resize(count);
+    if(count < 2)
     {
-        contours.push_back(projectContour(i-1, i));
-        normals.push_back(computeContourNormal(i));
+        // no direction yet, the contour faces +Z
+        if(count == 1)
+        {
+            directions[0] = Vector3T<T>(0, 0, 0);
+            planes[0].set(Vector3T<T>(0, 0, 1), path[0]);
+        }
+        updateChannels(0, count - 1);
+        return;
+    }
+
+    if(first < 0)
+        first = 0;
+    if(last > count - 1)
+        last = count - 1;
+
+    for(int i = first; i <= last; ++i)
+    {
+        if(i == 0)
+            directions[i] = path[1] - path[0];
+        else
+            directions[i] = path[i] - path[i-1];
     }
+
+    // plane at the end point is perpendicular to the last segment
+    for(int i = first; i <= last; ++i)
+    {
+        const Vector3T<T>& dir1 = directions[i];
+        const Vector3T<T>& dir2 = (i == count - 1) ? dir1 : directions[i+1];
+        planes[i].set(dir1 + dir2, path[i]);
+    }
+
+    updateChannels(first, last);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// project a contour to a plane at the path point
+// update the optional per point channels in [first, last] after the joints
+// An arc length depends on all segments before it, so the change at the last
+// point is added to the rest of the path.
 ///////////////////////////////////////////////////////////////////////////////
-std::vector<Vector3> Pipe::projectContour(int fromIndex, int toIndex)
+template<typename T>
+void PipeT<T>::updateChannels(int first, int last)
 {
-    Vector3 dir1, dir2, normal;
-    Line line;
+    int count = (int)path.size();
+    if(first < 0)
+        first = 0;
+    if(last > count - 1)
+        last = count - 1;
 
-    dir1 = path[toIndex] - path[fromIndex];
-    if(toIndex == (int)path.size()-1)
-        dir2 = dir1;
+    if(attributes & PIPE_ATTRIB_TANGENT)
+    {
+        tangents.resize(count);
+        for(int i = first; i <= last; ++i)
+            tangents[i] = computeTangent(i);
+    }
     else
-        dir2 = path[toIndex + 1] - path[toIndex];
+    {
+        tangents.clear();
+    }
 
-    normal = dir1 + dir2;               // normal vector of plane at toIndex
-    Plane plane(normal, path[toIndex]);
+    if(attributes & PIPE_ATTRIB_TEXCOORD)
+    {
+        // new points get 0 first, the evicted length stays at the first point
+        int oldCount = arcLengths.size();
+        arcLengths.resize(count, 0);
+        if(first > last)
+            return;
 
-    // project each vertex of contour to the plane
-    std::vector<Vector3>& fromContour = contours[fromIndex];
-    std::vector<Vector3> toContour;
-    int count = (int)fromContour.size();
-    for(int i = 0; i < count; ++i)
+        T oldLast = arcLengths[last];
+        for(int i = first; i <= last; ++i)
+        {
+            if(i == 0)
+            {
+                if(firstIndex == 0)
+                    arcLengths[0] = 0;
+            }
+            else
+            {
+                arcLengths[i] = arcLengths[i-1] + directions[i].length();
+            }
+        }
+
+        T delta = arcLengths[last] - oldLast;
+        for(int i = last + 1; i < oldCount && i < count; ++i)
+            arcLengths[i] += delta;
+    }
+    else
     {
-        line.set(dir1, fromContour[i]);
-        toContour.push_back(plane.intersect(line));
+        arcLengths.clear();
     }
+}
 
-    return toContour;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// project the previous contour to the plane at the path point
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::projectContour(const Contour& fromContour, int toIndex,
+                              Contour& toContour) const
+{
+    // project each vertex of contour to the joint plane along the segment
+    const Vector3T<T>& dir1 = directions[toIndex];
+    const PlaneT<T>& plane = planes[toIndex];
+    int count = (int)fromContour.size();
+    toContour.resize(count);
+    if(count > 0)
+        getKernels<T>().projectRing(&fromContour[0], count, dir1, plane.getNormal(), plane.getD(), &toContour[0]);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // transform the contour at the first path point
+// The contour itself is not modified, so it can be swept again after the
+// path is reset.
 ///////////////////////////////////////////////////////////////////////////////
-void Pipe::transformFirstContour()
+template<typename T>
+void PipeT<T>::transformFirstContour(const Layer& layer, Contour& firstContour) const
 {
+    const std::vector< Vector3T<T> >& contour = getPoints(layer);
     int pathCount = (int)path.size();
     int vertexCount = (int)contour.size();
-    Matrix4 matrix;
+    firstContour.resize(vertexCount);
+    Matrix4T<T> matrix;
 
     if(pathCount > 0)
     {
         // transform matrix
         if(pathCount > 1)
-            matrix.lookAt(path[1] - path[0]);
+            matrix.lookAt(directions[0]);
 
         matrix.translate(path[0]);
 
         // multiply matrix to the contour
-        // NOTE: the contour vertices are transformed here
-        //       MUST resubmit contour data if the path is resset to 0
-        for(int i = 0; i < vertexCount; ++i)
-        {
-            contour[i] = matrix * contour[i];
-        }
+        if(vertexCount > 0)
+            getKernels<T>().transformPoints(matrix.get(), &contour[0], vertexCount, &firstContour[0]);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the unit tangent at the path point
+// At a joint, it is the bisector of the 2 segments (the normal of the
+// projection plane); at the ends, it is the direction of the end segment.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+Vector3T<T> PipeT<T>::computeTangent(int pathIndex) const
+{
+    int count = (int)path.size();
+    if(count < 2)
+        return Vector3T<T>(0, 0, 1);    // no direction, same as the contour
+
+    const Vector3T<T>& dir1 = directions[pathIndex];
+    const Vector3T<T>& dir2 = (pathIndex == count - 1) ? dir1 : directions[pathIndex + 1];
+    return getPipeTangent(dir1, dir2);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the frame (rotation of the contour) at the path point
+// The first frame faces the contour to the first segment (same as
+// transformFirstContour()), then each frame is the previous one rotated by
+// the smallest rotation from the previous tangent to the current tangent.
+// For PIPE_SWEEP_PROJECT, it is the frame of the cross section of the
+// segment into the path point instead; the projection onto the bisecting
+// plane carries the cross section from a segment to the next one with the
+// smallest rotation between the segment directions.
+// The previous frame must be computed already.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+QuaternionT<T> PipeT<T>::computeFrame(int pathIndex) const
+{
+    if(pathIndex == 0)
+    {
+        if(path.size() < 2)
+            return QuaternionT<T>();    // identity
+
+        return getPipeFirstFrame(directions[0]);
     }
+
+    const QuaternionT<T>& prevFrame = frames[pathIndex - 1];
+    if(sweep == PIPE_SWEEP_PROJECT)
+        return getPipeNextFrame(prevFrame, prevFrame.rotate(Vector3T<T>(0, 0, 1)), directions[pathIndex]);
+
+    return getPipeNextFrame(prevFrame, computeTangent(pathIndex - 1), computeTangent(pathIndex));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the rotation of the profile normals at the path point
+// For PIPE_SWEEP_PROJECT, the frame of the segment is turned to the tangent
+// (the bisector) at the joint. The first contour is not projected, so its
+// frame is used as is.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+QuaternionT<T> PipeT<T>::computeNormalFrame(int pathIndex) const
+{
+    const QuaternionT<T>& frame = frames[pathIndex];
+    if(sweep == PIPE_SWEEP_FRAME || pathIndex == 0)
+        return frame;
+
+    return getPipeNextFrame(frame, frame.rotate(Vector3T<T>(0, 0, 1)), computeTangent(pathIndex));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// rotate the contour with the frame and move it to the path point
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeT<T>::rotateContour(const Layer& layer, int pathIndex, Contour& toContour) const
+{
+    const std::vector< Vector3T<T> >& contour = getPoints(layer);
+    int vertexCount = (int)contour.size();
+    toContour.resize(vertexCount);
+
+    Matrix4T<T> matrix = frames[pathIndex].getMatrix();
+    matrix.translate(path[pathIndex]);
+    if(vertexCount > 0)
+        getKernels<T>().transformPoints(matrix.get(), &contour[0], vertexCount, &toContour[0]);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// return normal vectors at the current path point
+// compute normal vectors of the contour at the path point
+// The precision of the radial normals follows VECTORS_PRECISION (see
+// Vectors.h). The profile normals are rotated without normalizing again.
+// The normals of an inward layer are flipped to face the path.
 ///////////////////////////////////////////////////////////////////////////////
-std::vector<Vector3> Pipe::computeContourNormal(int pathIndex)
+template<typename T>
+void PipeT<T>::computeContourNormal(const Layer& layer, const Contour& contour, int pathIndex,
+                                    Contour& contourNormal) const
 {
-    // get current contour and center point
-    std::vector<Vector3>& contour = contours[pathIndex];
-    Vector3 center = path[pathIndex];
+    // normals are not requested
+    if(!(attributes & PIPE_ATTRIB_NORMAL))
+    {
+        contourNormal.clear();
+        return;
+    }
 
-    std::vector<Vector3> contourNormal;
-    Vector3 normal;
-    for(int i = 0; i < (int)contour.size(); ++i)
+    int count = (int)contour.size();
+    contourNormal.resize(count);
+    if(count == 0)
+        return;
+
+    const ProfilePtr& profile = layer.profile;
+    if(normalMode == PIPE_NORMAL_PROFILE && profile && profile->getCount() == count)
     {
-        normal = (contour[i] - center).normalize();
-        contourNormal.push_back(normal);
+        Matrix4T<T> matrix = computeNormalFrame(pathIndex).getMatrix();
+        if(layer.inward)
+            matrix.scale(-1);
+        getKernels<T>().transformPoints(matrix.get(), &profile->getNormals()[0], count, &contourNormal[0]);
+        return;
     }
 
-    return contourNormal;
+    // center point of the contour
+    Vector3T<T> center = path[pathIndex];
+    getKernels<T>().computeRingNormals(&contour[0], count, center, &contourNormal[0]);
+    if(layer.inward)
+    {
+        for(int i = 0; i < count; ++i)
+            contourNormal[i] = -contourNormal[i];
+    }
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+///////////////////////////////////////////////////////////////////////////////
+template class PipeT<float>;
+template class PipeT<double>;
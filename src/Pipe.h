@@ -2,56 +2,316 @@
 // Pipe.h
 // ======
 // base contour following a path
-// The contour is a 2D shape on XY plane.
+// The contour is a 2D shape on XY plane. It is kept as an immutable profile
+// shared with other pipes (see ProfileRegistry.h); set() and setContour()
+// look up the profile registry, so pipes with the same contour refer to the
+// same points instead of copying them. The transformed contour at the first
+// path point is stored separately as the first ring.
+// The scalar type (float or double) of the path and contours is a template
+// parameter; Pipe and Piped are the instantiated types.
 //
-// Dependencies: Vector3, Plane, Line, Matrix4
+// There are 2 ways to sweep the contour along the path:
+// PIPE_SWEEP_PROJECT: (default) project the previous contour onto the plane
+//                     bisecting the joint, so the pipe keeps the same width
+//                     at sharp corners, but the contour is sheared there.
+// PIPE_SWEEP_FRAME:   propagate a rotation frame (quaternion) along the path
+//                     with the smallest rotation between the joint tangents,
+//                     and place the undistorted contour with it. There is no
+//                     twist around the tangent, and the frames can be
+//                     interpolated with slerp/nlerp.
+//
+// There are 2 ways to compute the normals:
+// PIPE_NORMAL_RADIAL:  (default) normalize the vector from the path point to
+//                      each vertex, which is right for circles only.
+// PIPE_NORMAL_PROFILE: rotate the unit normals of the profile, computed once
+//                      (see ProfileRegistry.h), with a 3x3 rotation per ring,
+//                      so there is no square root per vertex, and the normals
+//                      of any profile shape are correct. With
+//                      PIPE_SWEEP_PROJECT, the frame of the cross section is
+//                      carried along the segments (see getFrame()) and turned
+//                      to the bisecting plane at each joint.
+//
+// The attribute set selects the channels to compute; the others cost
+// nothing. Without PIPE_ATTRIB_NORMAL (e.g. collision proxies), the normal
+// lists are empty. The texture coordinates and tangents are per ring, and
+// writeVertices() interleaves all selected channels of a ring for upload.
+//
+// Several profiles (layers) can be swept along the same path at once, e.g.
+// the outer wall, the inner wall and the insulation of a double-walled pipe.
+// addLayer() adds a profile after the main one (layer 0); all layers share
+// the joint table and the frames, and one pass of a path point updates the
+// rings of every layer. Each layer is a separate mesh (getLayerContour()),
+// and buildCap() fills the annulus between 2 adjacent layers at an end of
+// the pipe. Add the layers from outside in, with the inner walls marked as
+// inward so their normals face the path. The layers must start at the same
+// angle, like the circles of ProfileRegistry::getCircle().
+//
+// The joint table keeps the direction of the segment into each path point and
+// the plane bisecting the joint there. It is updated only for the joints next
+// to the changed path points, and all ring operations read from it.
+//
+// Path points can be edited in place with setPathPoint()/movePathPoints().
+// The contours after the edited neighbourhood are pending until
+// sweepPending() recomputes them, and then the pipe is the same as a fresh
+// sweep of the edited path. The contours recomputed since the last
+// clearDirtyRange() are reported by getDirtyRange(), so only that slice needs
+// to be uploaded again.
+//
+// For long paths, setCheckpointInterval(K) keeps only every K-th contour
+// (and the last 2), and the others are reconstructed from the nearest
+// checkpoint by copyContours(first, count, ...). In this mode, the getters
+// of the stored contours (getContour(), getContours(), ...) return an empty
+// list for a released contour, so read the contours with copyContours() (or
+// copyLayerContours()) if the interval may be set.
+//
+// The per-point lists are BlockLists of fixed-size blocks with a block index,
+// so adding a path point (or a layer) never moves or copies the existing
+// contours, and a reference to a contour (and its vertex data) stays valid
+// until the contour is removed or recomputed with a different vertex count.
+//
+// The vertex data of the contours and normals are allocated from a
+// MemoryResource (the global heap by default). With a MonotonicArena, a batch
+// of pipes is generated without heap allocations per contour, and the memory
+// is released at once by the arena after the pipes are cleared or destroyed.
+//
+// For endless streams, setWindowSize(N) keeps only the last N path points.
+// The oldest point and its contour are evicted in O(1) when a new point is
+// added. The indices of the getters are relative to the oldest point kept;
+// getFirstIndex() returns the absolute index of it (the number of evicted
+// points), so a reader can keep stable offsets with (getFirstIndex() + index).
+// Once getFirstIndex() > 0, index 0 of the joint table keeps the joint of the
+// evicted path: getJointDirection(0) is the evicted segment into the first
+// point (not the first segment as on a new path), and getJointPlane(0) is the
+// plane bisecting that joint, which the first ring was built on. Moving one
+// of the first 2 points resets the joint to the one of a new path.
+//
+// Dependencies: Vector3, Plane, Line, Matrix4, Quaternion, BlockList,
+//               MemoryResource, ProfileRegistry
 //
 //  AUTHOR: Song ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-04-16
-// UPDATED: 2016-04-29
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef PIPE_H_DEF
 #define PIPE_H_DEF
 
 #include <vector>
+#include <deque>
 #include "Vectors.h"
+#include "Plane.h"
+#include "Quaternion.h"
+#include "BlockList.h"
+#include "MemoryResource.h"
+#include "ProfileRegistry.h"
+
+// the way to move the contour from a path point to the next
+enum PipeSweep
+{
+    PIPE_SWEEP_PROJECT = 0,     // project onto the plane at the joint
+    PIPE_SWEEP_FRAME            // rotate with the propagated frame
+};
+
+// the way to compute the normals of the contours
+enum PipeNormal
+{
+    PIPE_NORMAL_RADIAL = 0,     // from the path point to each vertex
+    PIPE_NORMAL_PROFILE         // rotate the normals of the profile with the ring frame
+};
+
+// optional vertex attributes (bit flags), the positions are always computed
+enum PipeAttribute
+{
+    PIPE_ATTRIB_POSITION    = 0,
+    PIPE_ATTRIB_NORMAL      = 1,    // normals of the contours (default)
+    PIPE_ATTRIB_TEXCOORD    = 2,    // u along the contour (0~1), v = arc length of the path
+    PIPE_ATTRIB_TANGENT     = 4,    // unit tangent of the path at each ring
+    PIPE_ATTRIB_RING_ID     = 8     // absolute index of the ring (see getFirstIndex())
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// frame propagation shared by PipeT and ImplicitPipeT
+///////////////////////////////////////////////////////////////////////////////
+// unit bisector of the 2 segment directions at a joint
+template<typename T>
+inline Vector3T<T> getPipeTangent(Vector3T<T> dir1, Vector3T<T> dir2)
+{
+    Vector3T<T> tangent = dir1.normalize() + dir2.normalize();
+    return tangent.normalize();
+}
+
+// frame facing the contour (+Z) to the direction, same as Matrix4::lookAt()
+template<typename T>
+inline QuaternionT<T> getPipeFirstFrame(const Vector3T<T>& dir)
+{
+    Matrix4T<T> matrix;
+    matrix.lookAt(dir);
+    return QuaternionT<T>::getQuaternion(matrix);
+}
+
+// rotate the previous frame by the smallest rotation between the tangents
+template<typename T>
+inline QuaternionT<T> getPipeNextFrame(const QuaternionT<T>& prevFrame,
+                                       const Vector3T<T>& prevTangent, const Vector3T<T>& tangent)
+{
+    QuaternionT<T> q = QuaternionT<T>::getQuaternion(prevTangent, tangent);
+    q *= prevFrame;
+    return q.normalize();           // remove the drift of long paths
+}
 
-class Pipe
+
+
+template<typename T>
+class PipeT
 {
 public:
+    // vertices (or normals) of a contour, allocated from the memory resource
+    typedef std::vector< Vector3T<T>, ResourceAllocator< Vector3T<T> > > Contour;
+    typedef typename ProfileRegistryT<T>::ProfilePtr ProfilePtr;
+
     // ctor/dtor
-    Pipe();
-    Pipe(const std::vector<Vector3>& pathPoints, const std::vector<Vector3>& contourPoints);
-    ~Pipe() {}
+    explicit PipeT(MemoryResource* resource = 0);
+    PipeT(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints,
+          MemoryResource* resource = 0);
+    ~PipeT() {}
 
     // setters/getters
-    void set(const std::vector<Vector3>& pathPoints, const std::vector<Vector3>& contourPoints);
-    void setPath(const std::vector<Vector3>& pathPoints);
-    void setContour(const std::vector<Vector3>& contourPoints);
-    void addPathPoint(const Vector3& point);
-
-    int getPathCount() const                                        { return (int)path.size(); }
-    const std::vector<Vector3>& getPathPoints() const               { return path; }
-    const Vector3& getPathPoint(int index) const                    { return path.at(index); }
-    int getContourCount() const                                     { return (int)contours.size(); }
-    const std::vector< std::vector<Vector3> >& getContours() const  { return contours; }
-    const std::vector<Vector3>& getContour(int index) const         { return contours.at(index); }
-    const std::vector< std::vector<Vector3> >& getNormals() const   { return normals; }
-    const std::vector<Vector3>& getNormal(int index) const          { return normals.at(index); }
+    void set(const std::vector< Vector3T<T> >& pathPoints, const std::vector< Vector3T<T> >& contourPoints);
+    void setPath(const std::vector< Vector3T<T> >& pathPoints);
+    void setContour(const std::vector< Vector3T<T> >& contourPoints);
+    void set(const std::vector< Vector3T<T> >& pathPoints, const ProfilePtr& profile);
+    void setProfile(const ProfilePtr& profile);
+    int  addLayer(const std::vector< Vector3T<T> >& contourPoints, bool inward = false);    // return layer index
+    int  addLayer(const ProfilePtr& profile, bool inward = false);
+    void removeLayers();                        // keep the main profile (layer 0) only
+    void addPathPoint(const Vector3T<T>& point);
+    void truncate(int count);                   // keep the first count path points only
+    void popPathPoint();                        // remove the last path point
+    void clear();                               // remove all path points and free the contour storage
+    void setPathPoint(int index, const Vector3T<T>& point);
+    void movePathPoints(int first, int count, const Vector3T<T>& offset);  // translate points [first, first+count)
+    int  sweepPending(int maxCount = -1);       // recompute pending contours after edit, return # of remaining
+    int  getPendingCount() const;
+    void cancelPending();
+    bool getDirtyRange(int& first, int& last) const;    // contours changed since clearDirtyRange()
+    void clearDirtyRange();
+    void setCheckpointInterval(int interval);   // keep every interval-th contour only, 0 to keep all
+    int getCheckpointInterval() const                                       { return checkpointInterval; }
+    void setWindowSize(int size);               // keep the last size path points only, 0 for no limit
+    int getWindowSize() const                                               { return windowSize; }
+    int getFirstIndex() const                                               { return firstIndex; }  // # of evicted points
+    void setSweep(PipeSweep sweep);
+    PipeSweep getSweep() const                                              { return sweep; }
+    void setNormalMode(PipeNormal mode);
+    PipeNormal getNormalMode() const                                        { return normalMode; }
+    void setAttributes(int attributes);         // PipeAttribute flags
+    int getAttributes() const                                               { return attributes; }
+    void setMemoryResource(MemoryResource* resource);   // regenerate the contours with the resource
+    MemoryResource* getMemoryResource() const                               { return resource; }
+
+    int getPathCount() const                                                { return (int)path.size(); }
+    const BlockList< Vector3T<T> >& getPathPoints() const                   { return path; }
+    const Vector3T<T>& getPathPoint(int index) const                        { return path.at(index); }
+    const std::vector< Vector3T<T> >& getBaseContour() const;
+    const ProfilePtr& getProfile() const                                    { return layers[0].profile; }
+    int getContourCount() const                                             { return (int)layers[0].contours.size(); }
+    // stored contours and normals, empty if released (see copyContours())
+    const BlockList<Contour>& getContours() const                           { return layers[0].contours; }
+    const Contour& getContour(int index) const                              { return layers[0].contours.at(index); }
+    const BlockList<Contour>& getNormals() const                            { return layers[0].normals; }
+    const Contour& getNormal(int index) const                               { return layers[0].normals.at(index); }
+    const QuaternionT<T>& getFrame(int index) const                         { return frames.at(index); }  // see frames, old if pending
+    void copyContours(int first, int count,                                 // copy or reconstruct a range
+                      std::vector<Contour>& dstContours,
+                      std::vector<Contour>& dstNormals) const;
+    int getLayerCount() const                                               { return (int)layers.size(); }
+    const ProfilePtr& getLayerProfile(int layer) const                      { return layers.at(layer).profile; }
+    bool isLayerInward(int layer) const                                     { return layers.at(layer).inward; }
+    // stored, empty if released (see copyLayerContours())
+    const BlockList<Contour>& getLayerContours(int layer) const             { return layers.at(layer).contours; }
+    const Contour& getLayerContour(int layer, int index) const              { return layers.at(layer).contours.at(index); }
+    const Contour& getLayerNormal(int layer, int index) const               { return layers.at(layer).normals.at(index); }
+    void copyLayerContours(int layer, int first, int count,                 // copy or reconstruct a range of a layer
+                           std::vector<Contour>& dstContours,
+                           std::vector<Contour>& dstNormals) const;
+    int buildCap(int layer, bool end, std::vector<float>& dst) const;       // annulus between layer and layer+1
+    T getArcLength(int index) const                                         { return arcLengths.at(index); }  // PIPE_ATTRIB_TEXCOORD
+    const Vector3T<T>& getTangent(int index) const                          { return tangents.at(index); }    // PIPE_ATTRIB_TANGENT
+    int getRingId(int index) const                                          { return firstIndex + index; }
+    int getVertexSize() const;                                              // # of floats per vertex
+    int writeVertices(int index, float* dst) const;                         // interleaved attributes of a contour
+    int writeVertices(int layer, int index, float* dst) const;
+    const PlaneT<T>& getJointPlane(int index) const                         { return planes.at(index); }
+    const Vector3T<T>& getJointDirection(int index) const                   { return directions.at(index); }  // see setWindowSize()
 
 protected:
 
 private:
+    // rings of a profile swept along the path
+    struct Layer
+    {
+        explicit Layer(const ProfilePtr& profile = ProfilePtr(), bool inward = false) : profile(profile), inward(inward) {}
+
+        ProfilePtr profile;                             // shared base contour (0 if not set)
+        BlockList<Contour> contours;
+        BlockList<Contour> normals;
+        std::vector<Contour> spareContours;             // storage of removed contours to reuse
+        std::vector<Contour> spareNormals;
+        bool inward;                                    // normals face the path (inner wall)
+    };
+
     // member functions
     void generateContours();
-    void transformFirstContour();
-    std::vector<Vector3> projectContour(int fromIndex, int toIndex);
-    std::vector<Vector3> computeContourNormal(int pathIndex);
-
-    std::vector<Vector3> path;
-    std::vector<Vector3> contour;
-    std::vector< std::vector<Vector3> > contours;
-    std::vector< std::vector<Vector3> > normals;
+    void updateJoints(int first, int last);
+    void updateChannels(int first, int last);
+    void updatePathRange(int first, int last);
+    void sweepContour(int pathIndex);
+    void sweepLayers(int pathIndex);
+    void moveRollIndex(int index);
+    void resizeContours(int count);
+    void evictPathPoints(int count);
+    void reconstructContour(const Layer& layer, int pathIndex, Contour& dst, Contour& buffer) const;
+    void restoreContour(Layer& layer, int pathIndex);
+    void releaseContour(int pathIndex);
+    void transformFirstContour(const Layer& layer, Contour& firstContour) const;
+    void projectContour(const Contour& fromContour, int toIndex, Contour& toContour) const;
+    Vector3T<T> computeTangent(int pathIndex) const;
+    QuaternionT<T> computeFrame(int pathIndex) const;
+    QuaternionT<T> computeNormalFrame(int pathIndex) const;
+    bool hasFrames() const                      { return sweep == PIPE_SWEEP_FRAME || normalMode == PIPE_NORMAL_PROFILE; }
+    void rotateContour(const Layer& layer, int pathIndex, Contour& toContour) const;
+    void computeContourNormal(const Layer& layer, const Contour& contour, int pathIndex, Contour& contourNormal) const;
+    static const std::vector< Vector3T<T> >& getPoints(const Layer& layer);
+
+    BlockList< Vector3T<T> > path;
+    std::deque<Layer> layers;                           // [0] is the main profile, always present;
+                                                        // a deque so addLayer() never moves the layers
+    BlockList< QuaternionT<T> > frames;                 // rotation of contours for PIPE_SWEEP_FRAME, or of the
+                                                        // cross section of segment into each point for
+                                                        // PIPE_SWEEP_PROJECT with PIPE_NORMAL_PROFILE
+    BlockList< Vector3T<T> > directions;                // segment into each joint, path[i]-path[i-1] ([0] = [1],
+                                                        // or the evicted segment after evictPathPoints())
+    BlockList< PlaneT<T> > planes;                      // plane bisecting each joint, normal = dir[i]+dir[i+1]
+    BlockList<T> arcLengths;                            // length of the path to each point (PIPE_ATTRIB_TEXCOORD)
+    BlockList< Vector3T<T> > tangents;                  // unit tangent at each point (PIPE_ATTRIB_TANGENT)
+    PipeSweep sweep;
+    PipeNormal normalMode;
+    int attributes;                                     // PipeAttribute flags
+    int checkpointInterval;                             // keep every N-th contour only (0 = keep all)
+    int pendingIndex;                                   // first contour to re-project after edit (-1 if none)
+    int rollIndex;                                      // first frame missing pendingRoll (-1 if none)
+    QuaternionT<T> pendingRoll;                         // rotation about the tangent to apply to the frames after
+                                                        // an edit, frames[i] * pendingRoll (PIPE_SWEEP_FRAME)
+    int dirtyFirst;                                     // range of changed contours (empty if first > last)
+    int dirtyLast;
+    int windowSize;                                     // max # of path points (0 = no limit)
+    int firstIndex;                                     // absolute index of the first path point
+    MemoryResource* resource;                           // storage of contours and normals
 };
+
+// float pipe for rendering, double pipe for long paths far from the origin
+// Both emit float vertices for OpenGL (see KernelTable::buildStrip).
+typedef PipeT<float>  Pipe;
+typedef PipeT<double> Piped;
+
 #endif
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// PipeLod.cpp
+// ===========
+// levels of detail of a pipe generated by a single sweep
+//
+// Dependencies: Vector3, Pipe, ProfileRegistry
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include "PipeLod.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the path and the profiles of the levels, then sweep them at once
+// The layers are set up on the empty path, so the path is swept only once.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PipeLodT<T>::set(const std::vector< Vector3T<T> >& pathPoints, const std::vector<ProfilePtr>& profiles)
+{
+    pipe.clear();
+    pipe.removeLayers();
+    errors.clear();
+    if(profiles.empty())
+    {
+        pipe.setProfile(ProfilePtr());
+        return;
+    }
+
+    pipe.setProfile(profiles[0]);
+    for(std::size_t i = 1; i < profiles.size(); ++i)
+        pipe.addLayer(profiles[i]);
+    pipe.setPath(pathPoints);
+
+    // errors against the finest level
+    static const std::vector< Vector3T<T> > empty;
+    const std::vector< Vector3T<T> >& finest = profiles[0] ? profiles[0]->getPoints() : empty;
+    for(std::size_t i = 0; i < profiles.size(); ++i)
+    {
+        if(i == 0)
+            errors.push_back(0);
+        else
+            errors.push_back(computeError(profiles[i] ? profiles[i]->getPoints() : empty, finest));
+    }
+}
+
+template<typename T>
+void PipeLodT<T>::set(const std::vector< Vector3T<T> >& pathPoints, T radius, const std::vector<int>& sectorCounts)
+{
+    std::vector<ProfilePtr> profiles;
+    for(std::size_t i = 0; i < sectorCounts.size(); ++i)
+        profiles.push_back(ProfileRegistryT<T>::getInstance().getCircle(radius, sectorCounts[i]));
+    set(pathPoints, profiles);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PipeLodT<T>::getVertexCount(int level) const
+{
+    const ProfilePtr& profile = pipe.getLayerProfile(level);
+    return profile ? profile->getCount() : 0;
+}
+
+// 2 triangles per edge of the profile between 2 rings
+template<typename T>
+int PipeLodT<T>::getTriangleCount(int level) const
+{
+    int vertexCount = getVertexCount(level);
+    int ringCount = pipe.getPathCount();
+    if(vertexCount < 2 || ringCount < 2)
+        return 0;
+    return 2 * (vertexCount - 1) * (ringCount - 1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the level with the fewest vertices whose error is within maxError
+// Level 0 is returned if no level is accurate enough.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PipeLodT<T>::selectLevel(T maxError) const
+{
+    int level = 0;
+    for(int i = 1; i < (int)errors.size(); ++i)
+    {
+        if(errors[i] <= maxError && getVertexCount(i) < getVertexCount(level))
+            level = i;
+    }
+    return level;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// symmetric distance between 2 profiles (polylines)
+// The larger of the distances from the points and edge midpoints of one
+// profile to the other profile.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+T PipeLodT<T>::computeError(const std::vector< Vector3T<T> >& points1, const std::vector< Vector3T<T> >& points2)
+{
+    T distance1 = computeDistance(points1, points2);
+    T distance2 = computeDistance(points2, points1);
+    return (distance1 > distance2) ? distance1 : distance2;
+}
+
+template<typename T>
+T PipeLodT<T>::computeDistance(const std::vector< Vector3T<T> >& points, const std::vector< Vector3T<T> >& polyline)
+{
+    int count = (int)points.size();
+    int lineCount = (int)polyline.size();
+    if(count == 0 || lineCount == 0)
+        return 0;
+
+    T maxDistance = 0;
+    for(int i = 0; i < count * 2 - 1; ++i)
+    {
+        // points at even i, midpoints of the edges at odd i
+        Vector3T<T> point = (i % 2 == 0) ? points[i / 2] : (points[i / 2] + points[i / 2 + 1]) * T(0.5);
+
+        // squared distance to the nearest edge
+        Vector3T<T> v = point - polyline[0];
+        T minDistance = v.dot(v);
+        for(int j = 0; j < lineCount - 1; ++j)
+        {
+            Vector3T<T> edge = polyline[j + 1] - polyline[j];
+            T lengthSquared = edge.dot(edge);
+            T t = (lengthSquared > 0) ? (point - polyline[j]).dot(edge) / lengthSquared : 0;
+            if(t < 0) t = 0;
+            if(t > 1) t = 1;
+            v = point - (polyline[j] + edge * t);
+            T distance = v.dot(v);
+            if(distance < minDistance)
+                minDistance = distance;
+        }
+        if(minDistance > maxDistance)
+            maxDistance = minDistance;
+    }
+    return std::sqrt(maxDistance);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+///////////////////////////////////////////////////////////////////////////////
+template class PipeLodT<float>;
+template class PipeLodT<double>;
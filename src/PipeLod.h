@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// PipeLod.h
+// =========
+// levels of detail of a pipe generated by a single sweep
+// Each level is a profile of different resolution (e.g. circles of 48, 12
+// and 6 sectors for display, distant view and collision). The levels are the
+// layers of one Pipe (see Pipe::addLayer()), so the path work (joints,
+// frames, tangents) is done once, and one pass over the path emits the rings
+// of all levels.
+//
+// Level 0 is the reference (the finest profile). The error of a level is the
+// largest distance between its profile and the profile of level 0 (both
+// ways, sampled at the points and the edge midpoints), in the units of the
+// profile. For a circle of radius r with n sectors, it is close to the
+// sagitta r * (1 - cos(pi / n)). The sweep moves the profile rigidly, so the
+// error holds on the rings as well, except at sharp joints where the
+// projection stretches all levels alike.
+//
+// A renderer converts its pixel tolerance to the units of the scene at the
+// distance of the pipe, then selectLevel() returns the cheapest level within
+// that error.
+//
+// Dependencies: Vector3, Pipe, ProfileRegistry
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PIPE_LOD_H_DEF
+#define PIPE_LOD_H_DEF
+
+#include <vector>
+#include "Vectors.h"
+#include "Pipe.h"
+#include "ProfileRegistry.h"
+
+template<typename T>
+class PipeLodT
+{
+public:
+    typedef typename PipeT<T>::Contour Contour;
+    typedef typename PipeT<T>::ProfilePtr ProfilePtr;
+
+    // ctor/dtor
+    PipeLodT() {}
+    ~PipeLodT() {}
+
+    // the profiles from the finest to the coarsest
+    void set(const std::vector< Vector3T<T> >& pathPoints, const std::vector<ProfilePtr>& profiles);
+    void set(const std::vector< Vector3T<T> >& pathPoints, T radius, const std::vector<int>& sectorCounts);   // circles
+    void addPathPoint(const Vector3T<T>& point)                     { pipe.addPathPoint(point); }
+
+    int getLevelCount() const                                       { return (int)errors.size(); }
+    int getRingCount() const                                        { return pipe.getPathCount(); }
+    int getVertexCount(int level) const;                            // per ring
+    int getTriangleCount(int level) const;                          // of the whole mesh
+    T getError(int level) const                                     { return errors.at(level); }
+    int selectLevel(T maxError) const;                              // fewest vertices within the error
+
+    const PipeT<T>& getPipe() const                                 { return pipe; }
+    PipeT<T>& getPipe()                                             { return pipe; }    // for settings and edits
+    const ProfilePtr& getProfile(int level) const                   { return pipe.getLayerProfile(level); }
+    // stored rings, empty if released by pipe checkpoints; use
+    // getPipe().copyLayerContours() if the checkpoint interval is set
+    const BlockList<Contour>& getContours(int level) const          { return pipe.getLayerContours(level); }
+    const Contour& getContour(int level, int index) const           { return pipe.getLayerContour(level, index); }
+    const Contour& getNormal(int level, int index) const            { return pipe.getLayerNormal(level, index); }
+
+    // distance between 2 profiles
+    static T computeError(const std::vector< Vector3T<T> >& points1, const std::vector< Vector3T<T> >& points2);
+
+protected:
+
+private:
+    static T computeDistance(const std::vector< Vector3T<T> >& points, const std::vector< Vector3T<T> >& polyline);
+
+    PipeT<T> pipe;                              // layer i is level i
+    std::vector<T> errors;                      // distance to level 0
+};
+
+typedef PipeLodT<float>  PipeLod;
+typedef PipeLodT<double> PipeLodd;
+
+#endif
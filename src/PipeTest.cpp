@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// PipeTest.cpp
+// ============
+// regression tests of Pipe and its consumers
+// Each test builds a small pipe, prints OK or FAILED, and the program fails
+// if any test fails. Build and run it with "make -f Makefile.linux selftest".
+//
+// Dependencies: Vectors, Pipe, QuantizedPipe
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "Vectors.h"
+#include "Pipe.h"
+#include "QuantizedPipe.h"
+
+const double PI = 3.141592653589793;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// helix along +Z and unit circle on XY plane
+///////////////////////////////////////////////////////////////////////////////
+std::vector<Vector3d> buildPath(int count)
+{
+    std::vector<Vector3d> points;
+    for(int i = 0; i < count; ++i)
+    {
+        double a = i * 0.2;
+        points.push_back(Vector3d(std::cos(a) * 5, std::sin(a) * 5, i * 0.5));
+    }
+    return points;
+}
+
+std::vector<Vector3d> buildCircle(double radius, int steps)
+{
+    std::vector<Vector3d> points;
+    for(int i = 0; i <= steps; ++i)
+    {
+        double a = 2 * PI * i / steps;
+        points.push_back(Vector3d(std::cos(a) * radius, std::sin(a) * radius, 0));
+    }
+    return points;
+}
+
+bool report(const char* name, bool passed)
+{
+    std::printf("%-40s %s\n", name, passed ? "OK" : "FAILED");
+    return passed;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// QuantizedPipe of a pipe without normals (PIPE_ATTRIB_POSITION only) keeps
+// the positions and writes zero normals
+///////////////////////////////////////////////////////////////////////////////
+bool testQuantizeWithoutNormals()
+{
+    Piped pipe;
+    pipe.setAttributes(PIPE_ATTRIB_POSITION);
+    pipe.set(buildPath(40), buildCircle(1, 16));
+
+    QuantizedPipeT<double, short> quantized(pipe, 16);
+    bool passed = quantized.getRingCount() == pipe.getContourCount();
+    for(int i = 0; passed && i < quantized.getRingCount(); ++i)
+    {
+        const Piped::Contour& ring = pipe.getContour(i);
+        for(int j = 0; passed && j < quantized.getVertexCount(); ++j)
+        {
+            const QuantizedVertex16& v = quantized.getVertices(i)[j];
+            passed = (quantized.getPosition(i, j) - ring[j]).length() < 1e-3 &&
+                     v.normal[0] == 0 && v.normal[1] == 0;
+        }
+    }
+    return report("quantize without normals", passed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// addLayer() keeps the contours of the existing layers in place, so a
+// reference taken before it is still valid after it
+///////////////////////////////////////////////////////////////////////////////
+bool testAddLayerKeepsContours()
+{
+    Piped pipe;
+    pipe.set(buildPath(100), buildCircle(1, 16));
+    pipe.addLayer(buildCircle(0.8, 16), true);
+
+    const Piped::Contour& ring = pipe.getContour(10);
+    const Vector3d* data = ring.data();
+    Vector3d point = ring[3];
+    for(int i = 0; i < 8; ++i)
+        pipe.addLayer(buildCircle(0.7 - i * 0.05, 16), true);
+
+    bool passed = &pipe.getContour(10) == &ring && ring.data() == data &&
+                  ring.size() == 17 && (ring[3] - point).length() < 1e-12;
+    return report("addLayer keeps contour references", passed);
+}
+
+
+
+int main()
+{
+    bool passed = testQuantizeWithoutNormals();
+    passed = testAddLayerKeepsContours() && passed;
+    return passed ? 0 : 1;
+}
@@ -7,16 +7,23 @@
 // NOTE:
 // 1. The default plane is z = 0 (a plane on XY axis)
 // 2. The distance is the length from the origin to the plane
+// 3. The length of normal (and the distance) is computed when it is first
+//    needed, so set() does not pay for a sqrt nobody reads
+// 4. The batch intersect() functions run the kernels of Kernels.h
+// 5. getFrustumPlanes() and testSpheres() are for view frustum culling
 //
-// Dependencies: Vector3, Line
+// Dependencies: Vector3, Line, Matrix4, VectorExpr, Kernels
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-19
-// UPDATED: 2017-06-29
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Plane.h"
+#include "VectorExpr.h"
+#include "Kernels.h"
 #include <iostream>
+#include <vector>
 
 
 
@@ -24,16 +31,19 @@
 // ctors
 // default plane is z = 0 (a plane on XY-axis)
 ///////////////////////////////////////////////////////////////////////////////
-Plane::Plane() : normal(Vector3(0,0,1)), d(0), normalLength(1), distance(0)
+template<typename T>
+PlaneT<T>::PlaneT() : normal(Vector3T<T>(0,0,1)), d(0), normalLength(1)
 {
 }
 
-Plane::Plane(float a, float b, float c, float d)
+template<typename T>
+PlaneT<T>::PlaneT(T a, T b, T c, T d)
 {
     set(a, b, c, d);
 }
 
-Plane::Plane(const Vector3& normal, const Vector3& point)
+template<typename T>
+PlaneT<T>::PlaneT(const Vector3T<T>& normal, const Vector3T<T>& point)
 {
     set(normal, point);
 }
@@ -45,7 +55,8 @@ Plane::Plane(const Vector3& normal, const Vector3& point)
 // aX + bY + cZ + d = 0
 // where (a, b, c) is unit normal vector, d = -(ax0 + by0 + cz0)
 ///////////////////////////////////////////////////////////////////////////////
-void Plane::printSelf() const
+template<typename T>
+void PlaneT<T>::printSelf() const
 {
     std::cout << "Plane(" << normal.x << ", " << normal.y << ", " << normal.z
               << ", " << d << ")" << std::endl;
@@ -56,22 +67,34 @@ void Plane::printSelf() const
 ///////////////////////////////////////////////////////////////////////////////
 // setters
 ///////////////////////////////////////////////////////////////////////////////
-void Plane::set(float a, float b, float c, float d)
+template<typename T>
+void PlaneT<T>::set(T a, T b, T c, T d)
 {
     normal.set(a, b, c);
     this->d = d;
-
-    // compute distance
-    normalLength = sqrtf(a*a + b*b + c*c);
-    distance = -d / normalLength;
+    normalLength = -1;              // compute it later when needed
 }
 
-void Plane::set(const Vector3& normal, const Vector3& point)
+template<typename T>
+void PlaneT<T>::set(const Vector3T<T>& normal, const Vector3T<T>& point)
 {
     this->normal = normal;
-    normalLength = normal.length();
     d = -normal.dot(point);         // -(a*x0 + b*y0 + c*z0)
-    distance = -d / normalLength;
+    normalLength = -1;              // compute it later when needed
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the length of normal vector
+// It is computed once on the first call after set()
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+T PlaneT<T>::getNormalLength() const
+{
+    if(normalLength < 0)
+        normalLength = normal.length();
+    return normalLength;
 }
 
 
@@ -84,10 +107,11 @@ void Plane::set(const Vector3& normal, const Vector3& point)
 // D = (a * Px + b * Py + c * Pz + d) / sqrt(a*a + b*b + c*c)
 // reference: www.songho.ca/math/plane.html
 ///////////////////////////////////////////////////////////////////////////////
-float Plane::getDistance(const Vector3& point)
+template<typename T>
+T PlaneT<T>::getDistance(const Vector3T<T>& point) const
 {
-    float dot = normal.dot(point);
-    return (dot + d) / normalLength;
+    T dot = normal.dot(point);
+    return (dot + d) / getNormalLength();
 }
 
 
@@ -96,13 +120,13 @@ float Plane::getDistance(const Vector3& point)
 // normalize
 // divide each coefficient by the length of normal
 ///////////////////////////////////////////////////////////////////////////////
-void Plane::normalize()
+template<typename T>
+void PlaneT<T>::normalize()
 {
-    float lengthInv = 1.0f / normalLength;
+    T lengthInv = inverseSqrt(normal.dot(normal));
     normal *= lengthInv;
-    normalLength = 1.0f;
+    normalLength = T(1);
     d *= lengthInv;
-    distance = -d;
 }
 
 
@@ -119,25 +143,26 @@ void Plane::normalize()
 //
 // t = -(a*x0 + b*y0 + c*z0 + d) / (a*x + b*x + c*x)
 ///////////////////////////////////////////////////////////////////////////////
-Vector3 Plane::intersect(const Line& line) const
+template<typename T>
+Vector3T<T> PlaneT<T>::intersect(const LineT<T>& line) const
 {
     // from line = p + t * v
-    Vector3 p = line.getPoint();        // (x0, y0, z0)
-    Vector3 v = line.getDirection();    // (x,  y,  z)
+    const Vector3T<T>& p = line.getPoint();     // (x0, y0, z0)
+    const Vector3T<T>& v = line.getDirection(); // (x,  y,  z)
 
     // dot products
-    float dot1 = normal.dot(p);         // a*x0 + b*y0 + c*z0
-    float dot2 = normal.dot(v);         // a*x + b*y + c*z
+    T dot1 = normal.dot(p);             // a*x0 + b*y0 + c*z0
+    T dot2 = normal.dot(v);             // a*x + b*y + c*z
 
     // if denominator=0, no intersect
     if(dot2 == 0)
-        return Vector3(NAN, NAN, NAN);
+        return Vector3T<T>(NAN, NAN, NAN);
 
     // find t = -(a*x0 + b*y0 + c*z0 + d) / (a*x + b*y + c*z)
-    float t = -(dot1 + d) / dot2;
+    T t = -(dot1 + d) / dot2;
 
-    // find intersection point
-    return p + (v * t);
+    // find intersection point (fused, no temporary for v * t)
+    return vexpr(p) + vexpr(v) * t;
 }
 
 
@@ -159,24 +184,25 @@ Vector3 Plane::intersect(const Line& line) const
 // Use the formula for intersecting 3 planes to find p0;
 // p0 = ((-d1*N2 + d2*N1) x V) / V dot V
 ///////////////////////////////////////////////////////////////////////////////
-Line Plane::intersect(const Plane& rhs) const
+template<typename T>
+LineT<T> PlaneT<T>::intersect(const PlaneT& rhs) const
 {
     // find direction vector of the intersection line
-    Vector3 v = normal.cross(rhs.getNormal());
+    Vector3T<T> v = normal.cross(rhs.getNormal());
 
     // if |direction| = 0, 2 planes are parallel (no intersect)
     // return a line with NaN
     if(v.x == 0 && v.y == 0 && v.z == 0)
-        return Line(Vector3(NAN, NAN, NAN), Vector3(NAN, NAN, NAN));
+        return LineT<T>(Vector3T<T>(NAN, NAN, NAN), Vector3T<T>(NAN, NAN, NAN));
 
     // find a point on the line, which is also on both planes
     // choose simple plane where d=0: ax + by + cz = 0
-    float dot = v.dot(v);                       // V dot V
-    Vector3 n1 = rhs.getD() * normal;           // d2 * N1
-    Vector3 n2 = -d * rhs.getNormal();          //-d1 * N2
-    Vector3 p = (n1 + n2).cross(v) / dot;       // (d2*N1-d1*N2) X V / V dot V
+    T dot = v.dot(v);                           // V dot V
+    Vector3T<T> n1 = rhs.getD() * normal;       // d2 * N1
+    Vector3T<T> n2 = -d * rhs.getNormal();      //-d1 * N2
+    Vector3T<T> p = (n1 + n2).cross(v) / dot;   // (d2*N1-d1*N2) X V / V dot V
 
-    return Line(v, p);
+    return LineT<T>(v, p);
 }
 
 
@@ -184,13 +210,14 @@ Line Plane::intersect(const Plane& rhs) const
 ///////////////////////////////////////////////////////////////////////////////
 // determine if it intersects with the line
 ///////////////////////////////////////////////////////////////////////////////
-bool Plane::isIntersected(const Line& line) const
+template<typename T>
+bool PlaneT<T>::isIntersected(const LineT<T>& line) const
 {
     // direction vector of line
-    Vector3 v = line.getDirection();
+    Vector3T<T> v = line.getDirection();
 
     // dot product with normal of the plane
-    float dot = normal.dot(v);  // a*Vx + b*Vy + c*Vz
+    T dot = normal.dot(v);      // a*Vx + b*Vy + c*Vz
 
     if(dot == 0)
         return false;
@@ -203,12 +230,161 @@ bool Plane::isIntersected(const Line& line) const
 ///////////////////////////////////////////////////////////////////////////////
 // determine if it intersects with the other plane
 ///////////////////////////////////////////////////////////////////////////////
-bool Plane::isIntersected(const Plane& plane) const
+template<typename T>
+bool PlaneT<T>::isIntersected(const PlaneT& plane) const
 {
     // check if 2 plane normals are same direction
-    Vector3 cross = normal.cross(plane.getNormal());
+    Vector3T<T> cross = normal.cross(plane.getNormal());
     if(cross.x == 0 && cross.y == 0 && cross.z == 0)
         return false;
     else
         return true;
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch intersection with lines
+// Line objects are copied to small blocks of points and directions on stack
+// first, then the block is passed to the kernel.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PlaneT<T>::intersect(const Vector3T<T>* points, const Vector3T<T>* dirs, int count,
+                         Vector3T<T>* dst, unsigned char* mask) const
+{
+    return getKernels<T>().intersectLinesPlane(points, dirs, count, normal, d, dst, mask);
+}
+
+template<typename T>
+int PlaneT<T>::intersect(const LineT<T>* lines, int count, Vector3T<T>* dst, unsigned char* mask) const
+{
+    const int BLOCK = 64;
+    Vector3T<T> points[BLOCK];
+    Vector3T<T> dirs[BLOCK];
+    const KernelTable<T>& kernels = getKernels<T>();
+
+    int hits = 0;
+    for(int i = 0; i < count; i += BLOCK)
+    {
+        int n = (count - i < BLOCK) ? count - i : BLOCK;
+        for(int j = 0; j < n; ++j)
+        {
+            points[j] = lines[i + j].getPoint();
+            dirs[j] = lines[i + j].getDirection();
+        }
+        hits += kernels.intersectLinesPlane(points, dirs, n, normal, d, dst + i, mask + i);
+    }
+    return hits;
+}
+
+template<typename T>
+int PlaneT<T>::intersect(const PlaneT<T>* planes, const LineT<T>* lines, int count,
+                         Vector3T<T>* dst, unsigned char* mask)
+{
+    const int BLOCK = 64;
+    Vector3T<T> points[BLOCK];
+    Vector3T<T> dirs[BLOCK];
+    Vector3T<T> normals[BLOCK];
+    T ds[BLOCK];
+    const KernelTable<T>& kernels = getKernels<T>();
+
+    int hits = 0;
+    for(int i = 0; i < count; i += BLOCK)
+    {
+        int n = (count - i < BLOCK) ? count - i : BLOCK;
+        for(int j = 0; j < n; ++j)
+        {
+            points[j] = lines[i + j].getPoint();
+            dirs[j] = lines[i + j].getDirection();
+            normals[j] = planes[i + j].getNormal();
+            ds[j] = planes[i + j].getD();
+        }
+        hits += kernels.intersectLinesPlanes(points, dirs, normals, ds, n, dst + i, mask + i);
+    }
+    return hits;
+}
+
+// The lines are copied to a block once, then the block is intersected with
+// each plane, so dst and mask hold planeCount * lineCount elements.
+template<typename T>
+int PlaneT<T>::intersect(const PlaneT<T>* planes, int planeCount, const LineT<T>* lines, int lineCount,
+                         Vector3T<T>* dst, unsigned char* mask)
+{
+    const int BLOCK = 64;
+    Vector3T<T> points[BLOCK];
+    Vector3T<T> dirs[BLOCK];
+    const KernelTable<T>& kernels = getKernels<T>();
+
+    int hits = 0;
+    for(int i = 0; i < lineCount; i += BLOCK)
+    {
+        int n = (lineCount - i < BLOCK) ? lineCount - i : BLOCK;
+        for(int j = 0; j < n; ++j)
+        {
+            points[j] = lines[i + j].getPoint();
+            dirs[j] = lines[i + j].getDirection();
+        }
+        for(int k = 0; k < planeCount; ++k)
+        {
+            int offset = k * lineCount + i;
+            hits += kernels.intersectLinesPlane(points, dirs, n, planes[k].getNormal(), planes[k].getD(),
+                                                dst + offset, mask + offset);
+        }
+    }
+    return hits;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// extract the frustum planes from the rows of the projection matrix
+// A point is inside if -w <= x, y, z <= w in clip space, so each plane is the
+// sum or difference of the 4th row and one of the first 3 rows (Gribb and
+// Hartmann). The matrix is column-major, so a row is every 4th element.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void PlaneT<T>::getFrustumPlanes(const Matrix4T<T>& matrix, PlaneT<T> planes[6])
+{
+    const T* m = matrix.get();
+    for(int i = 0; i < 3; ++i)
+    {
+        planes[i*2].set(m[3] + m[i], m[7] + m[i+4], m[11] + m[i+8], m[15] + m[i+12]);
+        planes[i*2+1].set(m[3] - m[i], m[7] - m[i+4], m[11] - m[i+8], m[15] - m[i+12]);
+    }
+    for(int i = 0; i < 6; ++i)
+        planes[i].normalize();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch culling of spheres
+// The planes are scaled to unit normals, so the distances compare with the
+// radii, then passed to the kernel as (a, b, c, d) of each plane.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int PlaneT<T>::testSpheres(const PlaneT<T>* planes, int planeCount,
+                           const T* x, const T* y, const T* z, const T* radii, int count,
+                           unsigned char* mask)
+{
+    std::vector<T> coeffs(planeCount * 4);
+    for(int i = 0; i < planeCount; ++i)
+    {
+        T length = planes[i].getNormalLength();
+        T invLength = (length > 0) ? 1 / length : 0;
+        coeffs[i*4]   = planes[i].getNormal().x * invLength;
+        coeffs[i*4+1] = planes[i].getNormal().y * invLength;
+        coeffs[i*4+2] = planes[i].getNormal().z * invLength;
+        coeffs[i*4+3] = planes[i].getD() * invLength;
+    }
+    return getKernels<T>().testSpheresPlanes(x, y, z, radii, count,
+                                              coeffs.empty() ? 0 : &coeffs[0], planeCount, mask);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation for single and double precision
+///////////////////////////////////////////////////////////////////////////////
+template class PlaneT<float>;
+template class PlaneT<double>;
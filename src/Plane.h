@@ -7,12 +7,18 @@
 // NOTE:
 // 1. The default plane is z = 0 (a plane on XY axis)
 // 2. The distance is the length from the origin to the plane
+// 3. The length of normal (and the distance) is computed when it is first
+//    needed, so set() does not pay for a sqrt nobody reads
+// 4. The batch intersect() functions run the kernels of Kernels.h
+// 5. getFrustumPlanes() extracts the 6 planes of the view frustum from a
+//    projection matrix; with (projection * modelview), the planes are in
+//    object space. testSpheres() culls bounding spheres against them.
 //
-// Dependencies: Vector3, Line
+// Dependencies: Vector3, Line, Matrix4
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-19
-// UPDATED: 2016-04-14
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef PLANE_H_DEF
@@ -20,44 +26,71 @@
 
 #include "Vectors.h"
 #include "Line.h"
+#include "Matrices.h"
 
-class Plane
+template<typename T>
+class PlaneT
 {
 public:
     // ctor/dtor
-    Plane();
-    Plane(float a, float b, float c, float d);          // 4 coeff of plane equation
-    Plane(const Vector3& normal, const Vector3& point); // a point on the plane and normal vector
-    ~Plane() {}
+    PlaneT();
+    PlaneT(T a, T b, T c, T d);                                 // 4 coeff of plane equation
+    PlaneT(const Vector3T<T>& normal, const Vector3T<T>& point);// a point on the plane and normal vector
+    ~PlaneT() {}
 
     // debug
     void printSelf() const;
 
     // setters/getters
-    void set(float a, float b, float c, float d);
-    void set(const Vector3& normal, const Vector3& point);  // set with  a point on the plane and normal
-    const Vector3& getNormal() const { return normal; }
-    float getD() const { return d; }                        // return 4th coefficient
-    float getNormalLength() const { return normalLength; }  // return length of normal
-    float getDistance() const { return distance; };         // return distance from the origin
-    float getDistance(const Vector3& point);                // return distance from the point
+    void set(T a, T b, T c, T d);
+    void set(const Vector3T<T>& normal, const Vector3T<T>& point);  // set with  a point on the plane and normal
+    const Vector3T<T>& getNormal() const { return normal; }
+    T getD() const { return d; }                                // return 4th coefficient
+    T getNormalLength() const;                                  // return length of normal
+    T getDistance() const { return -d / getNormalLength(); }    // return distance from the origin
+    T getDistance(const Vector3T<T>& point) const;              // return distance from the point
 
     // convert plane equation with unit normal vector
     void normalize();
 
     // for intersection
-    Vector3 intersect(const Line& line) const;              // intersect with a line
-    Line intersect(const Plane& plane) const;               // intersect with another plane
-    bool isIntersected(const Line& line) const;
-    bool isIntersected(const Plane& plane) const;
+    Vector3T<T> intersect(const LineT<T>& line) const;      // intersect with a line
+    LineT<T> intersect(const PlaneT& plane) const;          // intersect with another plane
+    bool isIntersected(const LineT<T>& line) const;
+    bool isIntersected(const PlaneT& plane) const;
+
+    // batch intersection with lines, written to dst (count points)
+    // mask[i] = 1 if i-th line intersects, otherwise 0 and dst[i] = NaN
+    // return # of intersections
+    int intersect(const Vector3T<T>* points, const Vector3T<T>* dirs, int count,
+                  Vector3T<T>* dst, unsigned char* mask) const;     // lines of SoA pair
+    int intersect(const LineT<T>* lines, int count, Vector3T<T>* dst, unsigned char* mask) const;
+    static int intersect(const PlaneT* planes, const LineT<T>* lines, int count,
+                         Vector3T<T>* dst, unsigned char* mask);    // plane i with line i
+    static int intersect(const PlaneT* planes, int planeCount, const LineT<T>* lines, int lineCount,
+                         Vector3T<T>* dst, unsigned char* mask);    // every plane with every line,
+                                                                    // [i * lineCount + j] = plane i with line j
+
+    // view frustum: left, right, bottom, top, near, far with unit normals facing inside
+    static void getFrustumPlanes(const Matrix4T<T>& matrix, PlaneT planes[6]);
+
+    // batch culling of spheres of SoA layout (x, y, z, radius)
+    // mask[i] = 0 if i-th sphere is entirely behind any plane, otherwise 1
+    // return # of spheres not culled
+    static int testSpheres(const PlaneT* planes, int planeCount,
+                           const T* x, const T* y, const T* z, const T* radii, int count,
+                           unsigned char* mask);
 
 protected:
 
 private:
-    Vector3 normal;     // normal vector of a plane
-    float d;            // coefficient of constant term: d = -(a*x0 + b*y0 + c*z0)
-    float normalLength; // length of normal vector
-    float distance;     // distance from origin to plane
+    Vector3T<T> normal;     // normal vector of a plane
+    T d;                    // coefficient of constant term: d = -(a*x0 + b*y0 + c*z0)
+    mutable T normalLength; // length of normal vector, computed on first use (<0 if not yet)
 };
 
+// aliases for single and double precision
+typedef PlaneT<float>  Plane;
+typedef PlaneT<double> Planed;
+
 #endif
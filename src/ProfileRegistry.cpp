@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// ProfileRegistry.cpp
+// ===================
+// immutable profiles (cross sections) shared by many pipes
+//
+// Dependencies: Vector3, Profiles
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstring>
+#include "ProfileRegistry.h"
+#include "Profiles.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+ProfileT<T>::ProfileT(const std::vector< Vector3T<T> >& points) : points(points), hash(computeHash(points)), closed(false)
+{
+    int count = (int)points.size();
+    if(count > 2)
+    {
+        // allow the rounding error of a contour generated with sin/cos
+        T size = (points[count / 2] - points[0]).length();
+        closed = points[count - 1].equal(points[0], size * T(1e-5));
+    }
+    computeNormals();
+    computeTexCoords();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare the points exactly
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+bool ProfileT<T>::isEqual(const std::vector< Vector3T<T> >& points) const
+{
+    if(points.size() != this->points.size())
+        return false;
+    return points.empty() || memcmp(&points[0], &this->points[0], points.size() * sizeof(Vector3T<T>)) == 0;
+}
+
+// FNV-1a of the bytes of the points
+template<typename T>
+std::size_t ProfileT<T>::computeHash(const std::vector< Vector3T<T> >& points)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    const unsigned char* bytes = points.empty() ? 0 : reinterpret_cast<const unsigned char*>(&points[0]);
+    std::size_t size = points.size() * sizeof(Vector3T<T>);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return (std::size_t)hash;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unit normals on XY plane, the average of the outward normals of the edges
+// before and after each point
+// The outward side is found from the orientation (signed area) of the
+// contour. The ends of an open contour have only one edge. A closed contour
+// wraps around, skipping the repeated last point.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void ProfileT<T>::computeNormals()
+{
+    int count = (int)points.size();
+    normals.assign(count, Vector3T<T>(0, 0, 0));
+    int n = closed ? count - 1 : count;     // # of distinct points
+    if(n < 2)
+        return;
+
+    // twice of the signed area, positive for counter-clockwise
+    T area = 0;
+    for(int i = 0; i < n; ++i)
+    {
+        const Vector3T<T>& p1 = points[i];
+        const Vector3T<T>& p2 = points[(i + 1) % n];
+        area += p1.x * p2.y - p2.x * p1.y;
+    }
+    T sign = (area < 0) ? T(-1) : T(1);
+
+    for(int i = 0; i < n; ++i)
+    {
+        Vector3T<T> normal(0, 0, 0);
+        if(closed || i > 0)
+        {
+            Vector3T<T> edge = points[i] - points[(i + n - 1) % n];
+            normal += Vector3T<T>(edge.y, -edge.x, 0).normalize();
+        }
+        if(closed || i < n - 1)
+        {
+            Vector3T<T> edge = points[(i + 1) % n] - points[i];
+            normal += Vector3T<T>(edge.y, -edge.x, 0).normalize();
+        }
+        normals[i] = normal.normalize() * sign;
+    }
+    if(closed)
+        normals[count - 1] = normals[0];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// length along the contour normalized to [0, 1]
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void ProfileT<T>::computeTexCoords()
+{
+    int count = (int)points.size();
+    texCoords.assign(count, 0);
+    for(int i = 1; i < count; ++i)
+        texCoords[i] = texCoords[i - 1] + (points[i] - points[i - 1]).length();
+
+    T length = (count > 0) ? texCoords[count - 1] : 0;
+    if(length > 0)
+    {
+        for(int i = 1; i < count; ++i)
+            texCoords[i] /= length;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// global registry
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+ProfileRegistryT<T>& ProfileRegistryT<T>::getInstance()
+{
+    static ProfileRegistryT registry;
+    return registry;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the shared profile with the points, create one if not found
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+typename ProfileRegistryT<T>::ProfilePtr ProfileRegistryT<T>::getProfile(const std::vector< Vector3T<T> >& points)
+{
+    std::size_t hash = ProfileT<T>::computeHash(points);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    typedef typename std::multimap< std::size_t, std::weak_ptr< const ProfileT<T> > >::iterator Iterator;
+    Iterator it = profiles.lower_bound(hash);
+    while(it != profiles.end() && it->first == hash)
+    {
+        ProfilePtr profile = it->second.lock();
+        if(!profile)
+        {
+            profiles.erase(it++);       // released by all pipes
+            continue;
+        }
+        if(profile->isEqual(points))
+            return profile;
+        ++it;
+    }
+
+    if(profiles.size() >= purgeSize)
+    {
+        removeExpired();
+        purgeSize = (profiles.size() * 2 > 64) ? profiles.size() * 2 : 64;
+    }
+
+    ProfilePtr profile = std::make_shared< const ProfileT<T> >(points);
+    profiles.insert(std::make_pair(hash, std::weak_ptr< const ProfileT<T> >(profile)));
+    return profile;
+}
+
+// use the compile-time unit circle if there is one for the sector count
+template<typename T>
+typename ProfileRegistryT<T>::ProfilePtr ProfileRegistryT<T>::getCircle(T radius, int sectors)
+{
+    std::vector< Vector3T<T> > points;
+    if(sectors >= 2)
+    {
+        const Vector3T<T>* unitCircle = getUnitCircle<T>(sectors);
+        for(int i = 0; i <= sectors; ++i)
+        {
+            if(unitCircle)
+            {
+                points.push_back(unitCircle[i] * radius);
+            }
+            else
+            {
+                T a = T(acos(-1.0) * 2 * i / sectors);
+                points.push_back(Vector3T<T>(radius * cos(a), radius * sin(a), 0));
+            }
+        }
+        points[sectors] = points[0];        // close exactly
+    }
+    return getProfile(points);
+}
+
+template<typename T>
+int ProfileRegistryT<T>::getCount()
+{
+    purge();
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int)profiles.size();
+}
+
+template<typename T>
+void ProfileRegistryT<T>::purge()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    removeExpired();
+}
+
+template<typename T>
+void ProfileRegistryT<T>::removeExpired()
+{
+    typedef typename std::multimap< std::size_t, std::weak_ptr< const ProfileT<T> > >::iterator Iterator;
+    for(Iterator it = profiles.begin(); it != profiles.end(); )
+    {
+        if(it->second.expired())
+            profiles.erase(it++);
+        else
+            ++it;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+///////////////////////////////////////////////////////////////////////////////
+template class ProfileT<float>;
+template class ProfileT<double>;
+template class ProfileRegistryT<float>;
+template class ProfileRegistryT<double>;
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// ProfileRegistry.h
+// =================
+// immutable profiles (cross sections) shared by many pipes
+// A profile keeps the contour points on XY plane and their unit normals,
+// which are computed once when the profile is created. It is never modified
+// after that, so pipes refer to the same profile with a shared pointer
+// instead of copying it, and a profile is freed when the last pipe releases
+// it.
+//
+// The registry finds an existing profile with the same points (by hash and
+// comparison) before creating a new one, so thousands of pipes set up with
+// the same contour share a single copy of it. The registry keeps weak
+// references only, and it is safe to use from multiple threads.
+//
+// The texture coordinate of each point is the length along the contour from
+// the first point divided by the total length (0 to 1).
+//
+// The normals are the averages of the outward normals of the 2 edges at each
+// point, so they are correct for any closed contour; for a circle, they are
+// the radial directions. A closed profile repeats the first point at the end
+// (see Profiles.h).
+//
+// Dependencies: Vector3, Profiles
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILE_REGISTRY_H_DEF
+#define PROFILE_REGISTRY_H_DEF
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include "Vectors.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// immutable profile
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class ProfileT
+{
+public:
+    explicit ProfileT(const std::vector< Vector3T<T> >& points);
+
+    int getCount() const                                    { return (int)points.size(); }
+    const std::vector< Vector3T<T> >& getPoints() const     { return points; }
+    const std::vector< Vector3T<T> >& getNormals() const    { return normals; }
+    const std::vector<T>& getTexCoords() const              { return texCoords; }
+    bool isClosed() const                                   { return closed; }
+    std::size_t getHash() const                             { return hash; }
+    bool isEqual(const std::vector< Vector3T<T> >& points) const;
+
+    static std::size_t computeHash(const std::vector< Vector3T<T> >& points);
+
+private:
+    void computeNormals();
+    void computeTexCoords();
+
+    std::vector< Vector3T<T> > points;
+    std::vector< Vector3T<T> > normals;
+    std::vector<T> texCoords;           // normalized length along the contour
+    std::size_t hash;
+    bool closed;                        // last point is same as the first
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// registry of shared profiles
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class ProfileRegistryT
+{
+public:
+    typedef std::shared_ptr< const ProfileT<T> > ProfilePtr;
+
+    // global registry used by Pipe
+    static ProfileRegistryT& getInstance();
+
+    ProfilePtr getProfile(const std::vector< Vector3T<T> >& points);  // shared, created if not found
+    ProfilePtr getCircle(T radius, int sectors);                     // circle on XY plane
+    int getCount();                                                  // # of profiles in use
+    void purge();                                                    // drop released profiles
+
+private:
+    ProfileRegistryT() : purgeSize(64) {}
+    void removeExpired();
+
+    std::multimap< std::size_t, std::weak_ptr< const ProfileT<T> > > profiles;
+    std::size_t purgeSize;              // remove released profiles when the map grows to this size
+    std::mutex mutex;
+};
+
+typedef ProfileT<float>  Profile;
+typedef ProfileT<double> Profiled;
+typedef ProfileRegistryT<float>  ProfileRegistry;
+typedef ProfileRegistryT<double> ProfileRegistryd;
+
+#endif
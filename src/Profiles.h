@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// Profiles.h
+// ==========
+// compile-time tables of the unit circle and common profiles (cross sections)
+// The tables are generated by constexpr functions, so they cost nothing at
+// startup and are placed in read-only memory, which is shared by all
+// processes using the same binary.
+//
+// A profile is a closed contour on XY plane; the last point is same as the
+// first one. The points of the unit circle are also its unit normals.
+//
+// NOTE: The tables need C++14 (MATH_HAS_CONSTEXPR). Otherwise getUnitCircle()
+// returns 0, and the caller falls back to generating the profile at run time.
+//
+// Dependencies: Vector3
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILES_H_DEF
+#define PROFILES_H_DEF
+
+#include "Vectors.h"
+
+#if MATH_HAS_CONSTEXPR
+
+///////////////////////////////////////////////////////////////////////////////
+// sine/cosine usable in constant expressions
+// The angle is reduced to [-pi, pi], then summed with Taylor series until the
+// terms are below double precision (error < 1e-15).
+///////////////////////////////////////////////////////////////////////////////
+constexpr double PROFILE_PI = 3.141592653589793238;
+
+constexpr double reduceAngle(double a)
+{
+    double turns = a / (2 * PROFILE_PI);
+    long long n = (long long)(turns < 0 ? turns - 0.5 : turns + 0.5);   // round
+    return a - n * (2 * PROFILE_PI);
+}
+
+constexpr double constSin(double a)
+{
+    double x = reduceAngle(a);
+    double term = x;
+    double sum = x;
+    for(int i = 1; i < 20; ++i)
+    {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constCos(double a)
+{
+    double x = reduceAngle(a);
+    double term = 1;
+    double sum = 1;
+    for(int i = 1; i < 20; ++i)
+    {
+        term *= -x * x / ((2 * i - 1) * (2 * i));
+        sum += term;
+    }
+    return sum;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// profile with fixed number of points (N segments, N+1 points)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, int N>
+struct ProfileTable
+{
+    Vector3T<T> points[N + 1];
+
+    constexpr int getCount() const          { return N + 1; }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unit circle on XY plane with N sectors, starting at (1, 0, 0)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, int N>
+constexpr ProfileTable<T, N> makeCircleTable()
+{
+    ProfileTable<T, N> table{};
+    for(int i = 0; i < N; ++i)
+    {
+        double a = 2 * PROFILE_PI * i / N;
+        table.points[i] = Vector3T<T>(T(constCos(a)), T(constSin(a)), T(0));
+    }
+    table.points[N] = table.points[0];      // close exactly
+    return table;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unit square on XY plane (half size 1), counter-clockwise from (1, 1, 0)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+constexpr ProfileTable<T, 4> makeSquareTable()
+{
+    ProfileTable<T, 4> table{};
+    table.points[0] = Vector3T<T>( 1,  1, 0);
+    table.points[1] = Vector3T<T>(-1,  1, 0);
+    table.points[2] = Vector3T<T>(-1, -1, 0);
+    table.points[3] = Vector3T<T>( 1, -1, 0);
+    table.points[4] = table.points[0];
+    return table;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the tables are instantiated only when they are used
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, int N>
+struct UnitCircle
+{
+    static constexpr ProfileTable<T, N> table = makeCircleTable<T, N>();
+};
+template<typename T, int N>
+constexpr ProfileTable<T, N> UnitCircle<T, N>::table;
+
+template<typename T>
+struct UnitSquare
+{
+    static constexpr ProfileTable<T, 4> table = makeSquareTable<T>();
+};
+template<typename T>
+constexpr ProfileTable<T, 4> UnitSquare<T>::table;
+
+#endif // MATH_HAS_CONSTEXPR
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the points (sectors + 1) of the unit circle table for the common
+// sector counts (8, 16, 32, 48, 64), or 0 if there is no table for it
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline const Vector3T<T>* getUnitCircle(int sectors)
+{
+#if MATH_HAS_CONSTEXPR
+    switch(sectors)
+    {
+    case 8:  return UnitCircle<T, 8>::table.points;
+    case 16: return UnitCircle<T, 16>::table.points;
+    case 32: return UnitCircle<T, 32>::table.points;
+    case 48: return UnitCircle<T, 48>::table.points;
+    case 64: return UnitCircle<T, 64>::table.points;
+    }
+#endif
+    (void)sectors;
+    return 0;
+}
+
+#endif
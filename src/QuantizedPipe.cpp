@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// QuantizedPipe.cpp
+// =================
+// compact copy of the rings of a pipe with quantized vertices
+//
+// Dependencies: Vector3, Pipe
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizedPipe.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctors
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename N>
+QuantizedPipeT<T, N>::QuantizedPipeT(int chunkSize) : chunkSize(chunkSize > 0 ? chunkSize : 0), ringCount(0), vertexCount(0)
+{
+}
+
+template<typename T, typename N>
+QuantizedPipeT<T, N>::QuantizedPipeT(const PipeT<T>& pipe, int chunkSize)
+: chunkSize(chunkSize > 0 ? chunkSize : 0), ringCount(0), vertexCount(0)
+{
+    set(pipe);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// setters
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename N>
+void QuantizedPipeT<T, N>::setChunkSize(int size)
+{
+    chunkSize = (size > 0) ? size : 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// quantize the rings of the pipe chunk by chunk
+// The rings are read with Pipe::copyContours(), so the released rings of a
+// keyframed pipe are reconstructed one chunk at a time.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename N>
+void QuantizedPipeT<T, N>::set(const PipeT<T>& pipe)
+{
+    ringCount = pipe.getContourCount();
+    vertexCount = (int)pipe.getBaseContour().size();
+    vertices.resize((std::size_t)ringCount * vertexCount);
+
+    int size = (chunkSize > 0) ? chunkSize : ringCount;
+    int chunkCount = (ringCount > 0 && size > 0) ? (ringCount + size - 1) / size : 0;
+    boxes.resize(chunkCount);
+
+    std::vector< typename PipeT<T>::Contour > contours;
+    std::vector< typename PipeT<T>::Contour > normals;
+    for(int i = 0; i < chunkCount; ++i)
+    {
+        int first = i * size;
+        pipe.copyContours(first, size, contours, normals);
+        quantizeChunk(i, contours, normals, first);
+    }
+}
+
+template<typename T, typename N>
+void QuantizedPipeT<T, N>::quantizeChunk(int chunk, const std::vector< typename PipeT<T>::Contour >& contours,
+                                         const std::vector< typename PipeT<T>::Contour >& normals, int firstRing)
+{
+    int count = (int)contours.size();
+
+    // bounding box of the chunk
+    Vector3T<T> minPoint, maxPoint;
+    bool empty = true;
+    for(int i = 0; i < count; ++i)
+    {
+        for(int j = 0; j < (int)contours[i].size(); ++j)
+        {
+            const Vector3T<T>& p = contours[i][j];
+            if(empty)
+            {
+                minPoint = maxPoint = p;
+                empty = false;
+                continue;
+            }
+            if(p.x < minPoint.x) minPoint.x = p.x;
+            if(p.y < minPoint.y) minPoint.y = p.y;
+            if(p.z < minPoint.z) minPoint.z = p.z;
+            if(p.x > maxPoint.x) maxPoint.x = p.x;
+            if(p.y > maxPoint.y) maxPoint.y = p.y;
+            if(p.z > maxPoint.z) maxPoint.z = p.z;
+        }
+    }
+
+    QuantizeBoxT<T>& box = boxes[chunk];
+    box.origin = minPoint;
+    box.scale = (maxPoint - minPoint) / T(65535);
+    Vector3T<T> invScale(box.scale.x > 0 ? 1 / box.scale.x : 0,
+                         box.scale.y > 0 ? 1 / box.scale.y : 0,
+                         box.scale.z > 0 ? 1 / box.scale.z : 0);
+
+    // the normal lists are empty without PIPE_ATTRIB_NORMAL; write zero normals
+    for(int i = 0; i < count; ++i)
+    {
+        Vertex* dst = &vertices[(std::size_t)(firstRing + i) * vertexCount];
+        bool hasNormals = (i < (int)normals.size() && (int)normals[i].size() == vertexCount);
+        for(int j = 0; j < vertexCount; ++j)
+        {
+            Vector3T<T> q = (contours[i][j] - box.origin) * invScale;
+            dst[j].position[0] = (unsigned short)(q.x + T(0.5));
+            dst[j].position[1] = (unsigned short)(q.y + T(0.5));
+            dst[j].position[2] = (unsigned short)(q.z + T(0.5));
+            if(hasNormals)
+                encodeOctahedral(normals[i][j], dst[j].normal);
+            else
+                dst[j].normal[0] = dst[j].normal[1] = 0;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// decode vertices
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename N>
+Vector3T<T> QuantizedPipeT<T, N>::getPosition(int ring, int index) const
+{
+    const QuantizeBoxT<T>& box = boxes[getChunkIndex(ring)];
+    const unsigned short* q = vertices[(std::size_t)ring * vertexCount + index].position;
+    return Vector3T<T>(box.origin.x + q[0] * box.scale.x,
+                       box.origin.y + q[1] * box.scale.y,
+                       box.origin.z + q[2] * box.scale.z);
+}
+
+template<typename T, typename N>
+Vector3T<T> QuantizedPipeT<T, N>::getNormal(int ring, int index) const
+{
+    return decodeOctahedral<T, N>(vertices[(std::size_t)ring * vertexCount + index].normal);
+}
+
+// decode a ring into caller buffers of getVertexCount() elements
+// dstNormals may be 0 to skip the normals
+template<typename T, typename N>
+void QuantizedPipeT<T, N>::decodeRing(int ring, Vector3T<T>* dstVertices, Vector3T<T>* dstNormals) const
+{
+    const QuantizeBoxT<T>& box = boxes[getChunkIndex(ring)];
+    const Vertex* src = getVertices(ring);
+    for(int i = 0; i < vertexCount; ++i)
+    {
+        if(dstVertices)
+        {
+            dstVertices[i].set(box.origin.x + src[i].position[0] * box.scale.x,
+                               box.origin.y + src[i].position[1] * box.scale.y,
+                               box.origin.z + src[i].position[2] * box.scale.z);
+        }
+        if(dstNormals)
+            dstNormals[i] = decodeOctahedral<T, N>(src[i].normal);
+    }
+}
+
+template<typename T, typename N>
+std::size_t QuantizedPipeT<T, N>::getMemorySize() const
+{
+    return vertices.size() * sizeof(Vertex) + boxes.size() * sizeof(QuantizeBoxT<T>);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// explicit instantiation
+///////////////////////////////////////////////////////////////////////////////
+template class QuantizedPipeT<float, signed char>;
+template class QuantizedPipeT<float, short>;
+template class QuantizedPipeT<double, signed char>;
+template class QuantizedPipeT<double, short>;
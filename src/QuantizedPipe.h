@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+// QuantizedPipe.h
+// ===============
+// compact copy of the rings of a pipe with quantized vertices
+// A vertex is stored as 16-bit unsigned integer position relative to the
+// bounding box of its chunk (a run of consecutive rings), and the normal is
+// encoded with the octahedral mapping into 2 signed 8-bit or 16-bit values:
+// QuantizedVertex8:  8 bytes per vertex (normal error < 1 degree)
+// QuantizedVertex16: 10 bytes per vertex (normal error < 0.01 degree)
+// where Pipe keeps 24 bytes (float) per vertex for the position and normal.
+//
+// The vertex layout is also a GPU vertex format; the chunk boxes are passed
+// as uniforms, and the vertex shader decodes them:
+//     position: 3 x GL_UNSIGNED_SHORT, not normalized, offset 0
+//               pos = box.origin + q * box.scale
+//     normal:   2 x GL_BYTE (or GL_SHORT), normalized, offset 6
+//               decodeOctahedral()
+//
+// CPU consumers read the vertices through the decoding accessors,
+// getPosition()/getNormal() or decodeRing(), which return Vector3 again.
+// The position error is at most half of box.scale on each axis, so smaller
+// chunks give more precision at the cost of 1 box per chunk.
+// A pipe without PIPE_ATTRIB_NORMAL has no normals to encode; its normals are
+// stored as (0, 0), which decodes to +Z.
+//
+// Dependencies: Vector3, Pipe
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef QUANTIZED_PIPE_H_DEF
+#define QUANTIZED_PIPE_H_DEF
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include "Vectors.h"
+#include "Pipe.h"
+
+// vertex with 16-bit position and octahedral normal of type N (signed char or short)
+template<typename N>
+struct QuantizedVertexT
+{
+    unsigned short position[3];
+    N normal[2];
+};
+typedef QuantizedVertexT<signed char> QuantizedVertex8;
+typedef QuantizedVertexT<short>       QuantizedVertex16;
+
+// box of a chunk: position = origin + q * scale (q = 0 ~ 65535)
+template<typename T>
+struct QuantizeBoxT
+{
+    Vector3T<T> origin;
+    Vector3T<T> scale;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// octahedral normal encoding
+// The unit vector is projected onto the octahedron |x|+|y|+|z| = 1, and the
+// lower half (z < 0) is folded over the diagonals, so (x, y) covers the
+// square [-1, 1] with nearly uniform precision.
+///////////////////////////////////////////////////////////////////////////////
+template<typename N>
+inline int getOctahedralMax()                       { return (sizeof(N) == 1) ? 127 : 32767; }
+
+template<typename T, typename N>
+inline void encodeOctahedral(const Vector3T<T>& normal, N dst[2])
+{
+    T sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if(sum == 0)
+    {
+        dst[0] = dst[1] = 0;
+        return;
+    }
+
+    T x = normal.x / sum;
+    T y = normal.y / sum;
+    if(normal.z < 0)
+    {
+        T foldX = (1 - std::fabs(y)) * (x >= 0 ? 1 : -1);
+        T foldY = (1 - std::fabs(x)) * (y >= 0 ? 1 : -1);
+        x = foldX;
+        y = foldY;
+    }
+
+    T max = (T)getOctahedralMax<N>();
+    dst[0] = (N)std::floor(x * max + T(0.5));
+    dst[1] = (N)std::floor(y * max + T(0.5));
+}
+
+template<typename T, typename N>
+inline Vector3T<T> decodeOctahedral(const N src[2])
+{
+    T max = (T)getOctahedralMax<N>();
+    T x = src[0] / max;
+    T y = src[1] / max;
+    T z = 1 - std::fabs(x) - std::fabs(y);
+    if(z < 0)
+    {
+        T foldX = (1 - std::fabs(y)) * (x >= 0 ? 1 : -1);
+        T foldY = (1 - std::fabs(x)) * (y >= 0 ? 1 : -1);
+        x = foldX;
+        y = foldY;
+    }
+    Vector3T<T> normal(x, y, z);
+    return normal.normalize();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// quantized rings of a pipe
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename N>
+class QuantizedPipeT
+{
+public:
+    typedef QuantizedVertexT<N> Vertex;
+
+    // ctor/dtor
+    explicit QuantizedPipeT(int chunkSize = 64);
+    QuantizedPipeT(const PipeT<T>& pipe, int chunkSize = 64);
+    ~QuantizedPipeT() {}
+
+    void set(const PipeT<T>& pipe);             // quantize all rings of the pipe
+    void setChunkSize(int size);                // # of rings per box, 0 for one box
+    int getChunkSize() const                                    { return chunkSize; }
+
+    int getRingCount() const                                    { return ringCount; }
+    int getVertexCount() const                                  { return vertexCount; }  // per ring
+    std::size_t getMemorySize() const;                          // bytes of vertices and boxes
+
+    // raw data for GPU upload
+    const std::vector<Vertex>& getVertexData() const            { return vertices; }
+    const Vertex* getVertices(int ring) const                   { return &vertices[ring * vertexCount]; }
+    int getChunkCount() const                                   { return (int)boxes.size(); }
+    int getChunkIndex(int ring) const                           { return chunkSize > 0 ? ring / chunkSize : 0; }
+    const QuantizeBoxT<T>& getChunkBox(int chunk) const         { return boxes[chunk]; }
+
+    // decode on read
+    Vector3T<T> getPosition(int ring, int index) const;
+    Vector3T<T> getNormal(int ring, int index) const;
+    void decodeRing(int ring, Vector3T<T>* dstVertices, Vector3T<T>* dstNormals) const;
+
+private:
+    void quantizeChunk(int chunk, const std::vector< typename PipeT<T>::Contour >& contours,
+                       const std::vector< typename PipeT<T>::Contour >& normals, int firstRing);
+
+    std::vector<Vertex> vertices;               // ringCount * vertexCount
+    std::vector< QuantizeBoxT<T> > boxes;       // one per chunk
+    int chunkSize;
+    int ringCount;
+    int vertexCount;
+};
+
+typedef QuantizedPipeT<float, signed char>  QuantizedPipe8;
+typedef QuantizedPipeT<float, short>        QuantizedPipe16;
+
+#endif
@@ -0,0 +1,356 @@
+///////////////////////////////////////////////////////////////////////////////
+// Quaternion.h
+// ============
+// Quaternion class for 3D rotation
+// q = s + xi + yj + zk, where s is scalar part and (x,y,z) is vector part
+// A unit quaternion rotating by angle a on unit axis (ax,ay,az) is
+// q = cos(a/2) + sin(a/2)*(ax*i + ay*j + az*k)
+//
+// NOTE: The angles are in radian, unlike Matrix4::rotate() (degree).
+// NOTE: The matrices are column-major, same as Matrices.h; the rotation matrix
+//       of q rotates a column vector: v' = M * v = q * v * q^-1
+//
+// Dependencies: Vector3, Matrix3, Matrix4
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef QUATERNION_H_DEF
+#define QUATERNION_H_DEF
+
+#include <cmath>
+#include <iostream>
+#include "Vectors.h"
+#include "Matrices.h"
+
+template<typename T>
+struct QuaternionT
+{
+    T s;    // scalar part, s = cos(angle/2)
+    T x;    // vector part
+    T y;
+    T z;
+
+    // ctors
+    MATH_CONSTEXPR QuaternionT() : s(1), x(0), y(0), z(0) {};                  // identity
+    MATH_CONSTEXPR QuaternionT(T s, T x, T y, T z) : s(s), x(x), y(y), z(z) {};
+    QuaternionT(const Vector3T<T>& axis, T angle);                      // rotation axis and angle (radian)
+
+    // util functions
+    MATH_CONSTEXPR QuaternionT& set(T s, T x, T y, T z);
+    inline         QuaternionT& set(const Vector3T<T>& axis, T angle);  // rotation axis and angle (radian)
+    inline         T            length() const;
+    inline         QuaternionT& normalize();
+    MATH_CONSTEXPR T            dot(const QuaternionT& rhs) const;
+    MATH_CONSTEXPR QuaternionT& conjugate();
+    inline         QuaternionT& invert();
+    inline         T            getAngle() const;                       // rotation angle (radian)
+    inline         Vector3T<T>  getAxis() const;                        // unit rotation axis
+    MATH_CONSTEXPR Vector3T<T>  rotate(const Vector3T<T>& v) const;     // rotate vector, q must be unit
+    MATH_CONSTEXPR Matrix3T<T>  getRotationMatrix() const;              // return 3x3 rotation matrix
+    MATH_CONSTEXPR Matrix4T<T>  getMatrix() const;                      // return 4x4 rotation matrix
+
+    // operators
+    MATH_CONSTEXPR QuaternionT  operator-() const;                      // unary operator (negate)
+    MATH_CONSTEXPR QuaternionT  operator+(const QuaternionT& rhs) const;
+    MATH_CONSTEXPR QuaternionT  operator-(const QuaternionT& rhs) const;
+    MATH_CONSTEXPR QuaternionT  operator*(T a) const;                   // scale
+    MATH_CONSTEXPR QuaternionT  operator*(const QuaternionT& rhs) const;// multiply: rotate rhs first, then this
+    MATH_CONSTEXPR QuaternionT& operator*=(const QuaternionT& rhs);
+    MATH_CONSTEXPR bool         operator==(const QuaternionT& rhs) const;
+    MATH_CONSTEXPR bool         operator!=(const QuaternionT& rhs) const;
+
+    // static functions
+    static QuaternionT getQuaternion(const Vector3T<T>& from, const Vector3T<T>& to); // shortest rotation from -> to
+    static QuaternionT getQuaternion(const Matrix3T<T>& m);            // from rotation matrix
+    static QuaternionT getQuaternion(const Matrix4T<T>& m);            // from upper-left 3x3 of matrix
+    static QuaternionT slerp(const QuaternionT& from, const QuaternionT& to, T t);  // spherical linear interpolation
+    static QuaternionT nlerp(const QuaternionT& from, const QuaternionT& to, T t);  // normalized linear interpolation
+
+    friend std::ostream& operator<<(std::ostream& os, const QuaternionT& q) {
+        os << "(" << q.s << ", " << q.x << ", " << q.y << ", " << q.z << ")";
+        return os;
+    }
+};
+
+// aliases for single and double precision
+typedef QuaternionT<float>  Quaternion;
+typedef QuaternionT<double> Quaterniond;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions for QuaternionT
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline QuaternionT<T>::QuaternionT(const Vector3T<T>& axis, T angle) {
+    set(axis, angle);
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T>& QuaternionT<T>::set(T s, T x, T y, T z) {
+    this->s = s; this->x = x; this->y = y; this->z = z; return *this;
+}
+
+template<typename T>
+inline QuaternionT<T>& QuaternionT<T>::set(const Vector3T<T>& axis, T angle) {
+    Vector3T<T> v = axis;
+    v.normalize();
+    T sine = std::sin(angle * T(0.5));
+    s = std::cos(angle * T(0.5));
+    x = v.x * sine;
+    y = v.y * sine;
+    z = v.z * sine;
+    return *this;
+}
+
+template<typename T>
+inline T QuaternionT<T>::length() const {
+    return std::sqrt(s*s + x*x + y*y + z*z);
+}
+
+template<typename T>
+inline QuaternionT<T>& QuaternionT<T>::normalize() {
+    T invLength = inverseSqrt(s*s + x*x + y*y + z*z);
+    s *= invLength; x *= invLength; y *= invLength; z *= invLength;
+    return *this;
+}
+
+template<typename T>
+MATH_CONSTEXPR T QuaternionT<T>::dot(const QuaternionT<T>& rhs) const {
+    return s*rhs.s + x*rhs.x + y*rhs.y + z*rhs.z;
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T>& QuaternionT<T>::conjugate() {
+    x = -x; y = -y; z = -z; return *this;
+}
+
+template<typename T>
+inline QuaternionT<T>& QuaternionT<T>::invert() {
+    // q^-1 = q* / |q|^2
+    const T EPSILON = T(0.00001);
+    T d = s*s + x*x + y*y + z*z;
+    if(d < EPSILON)
+        return *this;   // do nothing if it is zero
+    T dInv = T(1) / d;
+    s *= dInv; x *= -dInv; y *= -dInv; z *= -dInv;
+    return *this;
+}
+
+template<typename T>
+inline T QuaternionT<T>::getAngle() const {
+    T c = s < T(-1) ? T(-1) : (s > T(1) ? T(1) : s);
+    return T(2) * std::acos(c);
+}
+
+template<typename T>
+inline Vector3T<T> QuaternionT<T>::getAxis() const {
+    Vector3T<T> axis(x, y, z);
+    T xxyyzz = x*x + y*y + z*z;
+    if(xxyyzz == 0)
+        return Vector3T<T>(1, 0, 0);    // no rotation, any axis
+    return axis * inverseSqrt(xxyyzz);
+}
+
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> QuaternionT<T>::rotate(const Vector3T<T>& v) const {
+    // v' = v + 2s(u x v) + 2u x (u x v), where u = (x,y,z)
+    Vector3T<T> u(x, y, z);
+    Vector3T<T> uv = u.cross(v);
+    Vector3T<T> uuv = u.cross(uv);
+    return v + (uv * s + uuv) * T(2);
+}
+
+template<typename T>
+MATH_CONSTEXPR Matrix3T<T> QuaternionT<T>::getRotationMatrix() const {
+    T x2 = x + x, y2 = y + y, z2 = z + z;
+    T xx = x * x2, xy = x * y2, xz = x * z2;
+    T yy = y * y2, yz = y * z2, zz = z * z2;
+    T sx = s * x2, sy = s * y2, sz = s * z2;
+    return Matrix3T<T>(T(1) - (yy + zz), xy + sz, xz - sy,     // 1st column
+                       xy - sz, T(1) - (xx + zz), yz + sx,     // 2nd column
+                       xz + sy, yz - sx, T(1) - (xx + yy));    // 3rd column
+}
+
+template<typename T>
+MATH_CONSTEXPR Matrix4T<T> QuaternionT<T>::getMatrix() const {
+    T x2 = x + x, y2 = y + y, z2 = z + z;
+    T xx = x * x2, xy = x * y2, xz = x * z2;
+    T yy = y * y2, yz = y * z2, zz = z * z2;
+    T sx = s * x2, sy = s * y2, sz = s * z2;
+    return Matrix4T<T>(T(1) - (yy + zz), xy + sz, xz - sy, 0,  // 1st column
+                       xy - sz, T(1) - (xx + zz), yz + sx, 0,  // 2nd column
+                       xz + sy, yz - sx, T(1) - (xx + yy), 0,  // 3rd column
+                       0, 0, 0, 1);                            // 4th column
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator-() const {
+    return QuaternionT<T>(-s, -x, -y, -z);
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator+(const QuaternionT<T>& rhs) const {
+    return QuaternionT<T>(s+rhs.s, x+rhs.x, y+rhs.y, z+rhs.z);
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator-(const QuaternionT<T>& rhs) const {
+    return QuaternionT<T>(s-rhs.s, x-rhs.x, y-rhs.y, z-rhs.z);
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator*(T a) const {
+    return QuaternionT<T>(a*s, a*x, a*y, a*z);
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator*(const QuaternionT<T>& rhs) const {
+    // qq' = (ss' - v.v', s*v' + s'*v + v x v')
+    return QuaternionT<T>(s*rhs.s - x*rhs.x - y*rhs.y - z*rhs.z,
+                          s*rhs.x + x*rhs.s + y*rhs.z - z*rhs.y,
+                          s*rhs.y - x*rhs.z + y*rhs.s + z*rhs.x,
+                          s*rhs.z + x*rhs.y - y*rhs.x + z*rhs.s);
+}
+
+template<typename T>
+MATH_CONSTEXPR QuaternionT<T>& QuaternionT<T>::operator*=(const QuaternionT<T>& rhs) {
+    *this = *this * rhs; return *this;
+}
+
+template<typename T>
+MATH_CONSTEXPR bool QuaternionT<T>::operator==(const QuaternionT<T>& rhs) const {
+    return (s == rhs.s) && (x == rhs.x) && (y == rhs.y) && (z == rhs.z);
+}
+
+template<typename T>
+MATH_CONSTEXPR bool QuaternionT<T>::operator!=(const QuaternionT<T>& rhs) const {
+    return (s != rhs.s) || (x != rhs.x) || (y != rhs.y) || (z != rhs.z);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the shortest rotation from a vector to another
+// q = (1 + a.b, a x b) normalized, which is the half angle of a and b
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline QuaternionT<T> QuaternionT<T>::getQuaternion(const Vector3T<T>& from, const Vector3T<T>& to)
+{
+    const T EPSILON = T(0.000001);
+    Vector3T<T> a = from;
+    Vector3T<T> b = to;
+    a.normalize();
+    b.normalize();
+
+    T d = a.dot(b);
+    if(d < T(-1) + EPSILON)
+    {
+        // opposite vectors, rotate 180 degree on any perpendicular axis
+        Vector3T<T> axis = Vector3T<T>(1, 0, 0).cross(a);
+        if(axis.dot(axis) < EPSILON)
+            axis = Vector3T<T>(0, 1, 0).cross(a);
+        axis.normalize();
+        return QuaternionT<T>(0, axis.x, axis.y, axis.z);
+    }
+
+    Vector3T<T> c = a.cross(b);
+    QuaternionT<T> q(T(1) + d, c.x, c.y, c.z);
+    return q.normalize();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert rotation matrix to quaternion
+// choose the largest of s, x, y, z first to avoid dividing by a small number
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline QuaternionT<T> getQuaternionFromRotation(T r00, T r01, T r02,
+                                                T r10, T r11, T r12,
+                                                T r20, T r21, T r22)
+{
+    T trace = r00 + r11 + r22;
+    T k;
+    if(trace > 0)
+    {
+        k = T(0.5) / std::sqrt(trace + T(1));
+        return QuaternionT<T>(T(0.25) / k, (r21 - r12) * k, (r02 - r20) * k, (r10 - r01) * k);
+    }
+    else if(r00 > r11 && r00 > r22)
+    {
+        k = T(0.5) / std::sqrt(T(1) + r00 - r11 - r22);
+        return QuaternionT<T>((r21 - r12) * k, T(0.25) / k, (r01 + r10) * k, (r02 + r20) * k);
+    }
+    else if(r11 > r22)
+    {
+        k = T(0.5) / std::sqrt(T(1) + r11 - r00 - r22);
+        return QuaternionT<T>((r02 - r20) * k, (r01 + r10) * k, T(0.25) / k, (r12 + r21) * k);
+    }
+    else
+    {
+        k = T(0.5) / std::sqrt(T(1) + r22 - r00 - r11);
+        return QuaternionT<T>((r10 - r01) * k, (r02 + r20) * k, (r12 + r21) * k, T(0.25) / k);
+    }
+}
+
+template<typename T>
+inline QuaternionT<T> QuaternionT<T>::getQuaternion(const Matrix3T<T>& m)
+{
+    // rij = m[j*3 + i] (column-major)
+    return getQuaternionFromRotation(m[0], m[3], m[6],
+                                     m[1], m[4], m[7],
+                                     m[2], m[5], m[8]);
+}
+
+template<typename T>
+inline QuaternionT<T> QuaternionT<T>::getQuaternion(const Matrix4T<T>& m)
+{
+    // rij = m[j*4 + i] (column-major)
+    return getQuaternionFromRotation(m[0], m[4], m[8],
+                                     m[1], m[5], m[9],
+                                     m[2], m[6], m[10]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// interpolate 2 unit quaternions along the shortest arc
+// slerp is constant speed; nlerp is cheaper (no trig) and close to slerp for
+// small angles, which is the case between nearby path frames
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline QuaternionT<T> QuaternionT<T>::slerp(const QuaternionT<T>& from, const QuaternionT<T>& to, T t)
+{
+    const T EPSILON = T(0.0005);
+    T cosine = from.dot(to);
+    QuaternionT<T> q2 = to;
+    if(cosine < 0)
+    {
+        // q and -q are same rotation; take the shorter one
+        cosine = -cosine;
+        q2 = -to;
+    }
+
+    // use nlerp if they are too close, sin(angle) ~ 0
+    if(cosine > T(1) - EPSILON)
+        return nlerp(from, q2, t);
+
+    T angle = std::acos(cosine);
+    T sineInv = T(1) / std::sin(angle);
+    T a = std::sin((T(1) - t) * angle) * sineInv;
+    T b = std::sin(t * angle) * sineInv;
+    return from * a + q2 * b;
+}
+
+template<typename T>
+inline QuaternionT<T> QuaternionT<T>::nlerp(const QuaternionT<T>& from, const QuaternionT<T>& to, T t)
+{
+    QuaternionT<T> q2 = (from.dot(to) < 0) ? -to : to;
+    QuaternionT<T> q = from * (T(1) - t) + q2 * t;
+    return q.normalize();
+}
+
+#endif
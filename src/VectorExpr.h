@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+// VectorExpr.h
+// ============
+// optional expression templates for Vector3T
+// An expression such as p + v * t is not evaluated by each operator; it is
+// built as a small tree of nodes and evaluated in a single pass when it
+// is converted to Vector3T, so no temporary Vector3T is created for the
+// intermediate terms. The same expression over arrays is evaluated with
+// evaluate() as one plain loop, which the compiler can vectorize.
+//
+// The layer is opt-in; the operators of Vector3T are untouched. Wrap the
+// operands with vexpr() (a vector or an array of vectors) and sexpr() (an
+// array of scalars) to build an expression:
+//
+//  Vector3 q = vexpr(p) + vexpr(v) * t;                 // single vector
+//  evaluate(dst, n, vexpr(src) + vexpr(dir) * sexpr(t));  // dst[i] = src[i] + dir*t[i]
+//
+// NOTE: The nodes are small and copied by value, but the leaves refer to the
+// operand vectors, so an expression must not outlive its operands.
+//
+// Dependencies: Vector3
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECTOR_EXPR_H_DEF
+#define VECTOR_EXPR_H_DEF
+
+#include "Vectors.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// base of all vector expressions (CRTP)
+// x(i), y(i), z(i) return the components of i-th element; single vector
+// operands ignore the index
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename E>
+struct Vector3Expr
+{
+    const E& self() const               { return static_cast<const E&>(*this); }
+    T x(int i) const                    { return self().x(i); }
+    T y(int i) const                    { return self().y(i); }
+    T z(int i) const                    { return self().z(i); }
+
+    // evaluate a single vector expression
+    operator Vector3T<T>() const        { return Vector3T<T>(self().x(0), self().y(0), self().z(0)); }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// leaf nodes
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct Vector3Ref : public Vector3Expr<T, Vector3Ref<T> >
+{
+    const Vector3T<T>& v;
+    explicit Vector3Ref(const Vector3T<T>& v) : v(v) {}
+    T x(int) const                      { return v.x; }
+    T y(int) const                      { return v.y; }
+    T z(int) const                      { return v.z; }
+};
+
+template<typename T>
+struct Vector3ArrayRef : public Vector3Expr<T, Vector3ArrayRef<T> >
+{
+    const Vector3T<T>* v;
+    explicit Vector3ArrayRef(const Vector3T<T>* v) : v(v) {}
+    T x(int i) const                    { return v[i].x; }
+    T y(int i) const                    { return v[i].y; }
+    T z(int i) const                    { return v[i].z; }
+};
+
+// scalar operands: a single value or an array of values
+template<typename T>
+struct ScalarValue
+{
+    T s;
+    explicit ScalarValue(T s) : s(s) {}
+    T value(int) const                  { return s; }
+};
+
+template<typename T>
+struct ScalarArrayRef
+{
+    const T* s;
+    explicit ScalarArrayRef(const T* s) : s(s) {}
+    T value(int i) const                { return s[i]; }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// operation nodes
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename L, typename R>
+struct Vector3Add : public Vector3Expr<T, Vector3Add<T, L, R> >
+{
+    L lhs;
+    R rhs;
+    Vector3Add(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+    T x(int i) const                    { return lhs.x(i) + rhs.x(i); }
+    T y(int i) const                    { return lhs.y(i) + rhs.y(i); }
+    T z(int i) const                    { return lhs.z(i) + rhs.z(i); }
+};
+
+template<typename T, typename L, typename R>
+struct Vector3Sub : public Vector3Expr<T, Vector3Sub<T, L, R> >
+{
+    L lhs;
+    R rhs;
+    Vector3Sub(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+    T x(int i) const                    { return lhs.x(i) - rhs.x(i); }
+    T y(int i) const                    { return lhs.y(i) - rhs.y(i); }
+    T z(int i) const                    { return lhs.z(i) - rhs.z(i); }
+};
+
+template<typename T, typename E, typename S>
+struct Vector3Scale : public Vector3Expr<T, Vector3Scale<T, E, S> >
+{
+    E vec;
+    S scale;
+    Vector3Scale(const E& vec, const S& scale) : vec(vec), scale(scale) {}
+    T x(int i) const                    { return vec.x(i) * scale.value(i); }
+    T y(int i) const                    { return vec.y(i) * scale.value(i); }
+    T z(int i) const                    { return vec.z(i) * scale.value(i); }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// wrap operands into expressions
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline Vector3Ref<T> vexpr(const Vector3T<T>& v)
+{
+    return Vector3Ref<T>(v);
+}
+
+template<typename T>
+inline Vector3ArrayRef<T> vexpr(const Vector3T<T>* v)
+{
+    return Vector3ArrayRef<T>(v);
+}
+
+template<typename T>
+inline ScalarArrayRef<T> sexpr(const T* s)
+{
+    return ScalarArrayRef<T>(s);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// operators on expressions
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename L, typename R>
+inline Vector3Add<T, L, R> operator+(const Vector3Expr<T, L>& lhs, const Vector3Expr<T, R>& rhs)
+{
+    return Vector3Add<T, L, R>(lhs.self(), rhs.self());
+}
+
+template<typename T, typename L, typename R>
+inline Vector3Sub<T, L, R> operator-(const Vector3Expr<T, L>& lhs, const Vector3Expr<T, R>& rhs)
+{
+    return Vector3Sub<T, L, R>(lhs.self(), rhs.self());
+}
+
+template<typename T, typename E>
+inline Vector3Scale<T, E, ScalarValue<T> > operator*(const Vector3Expr<T, E>& vec, const T scale)
+{
+    return Vector3Scale<T, E, ScalarValue<T> >(vec.self(), ScalarValue<T>(scale));
+}
+
+template<typename T, typename E>
+inline Vector3Scale<T, E, ScalarValue<T> > operator*(const T scale, const Vector3Expr<T, E>& vec)
+{
+    return Vector3Scale<T, E, ScalarValue<T> >(vec.self(), ScalarValue<T>(scale));
+}
+
+template<typename T, typename E>
+inline Vector3Scale<T, E, ScalarArrayRef<T> > operator*(const Vector3Expr<T, E>& vec, const ScalarArrayRef<T>& scale)
+{
+    return Vector3Scale<T, E, ScalarArrayRef<T> >(vec.self(), scale);
+}
+
+template<typename T, typename E>
+inline Vector3Scale<T, E, ScalarArrayRef<T> > operator*(const ScalarArrayRef<T>& scale, const Vector3Expr<T, E>& vec)
+{
+    return Vector3Scale<T, E, ScalarArrayRef<T> >(vec.self(), scale);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// evaluate an expression over arrays in one loop: dst[i] = expr(i)
+// dst may be one of the operand arrays; each element reads only its own index
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, typename E>
+inline void evaluate(Vector3T<T>* dst, int count, const Vector3Expr<T, E>& expr)
+{
+    const E& e = expr.self();
+    for(int i = 0; i < count; ++i)
+    {
+        T x = e.x(i);
+        T y = e.y(i);
+        T z = e.z(i);
+        dst[i].x = x;
+        dst[i].y = y;
+        dst[i].z = z;
+    }
+}
+
+#endif
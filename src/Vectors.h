@@ -5,7 +5,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2007-02-14
-// UPDATED: 2020-06-29
+// UPDATED: 2026-10-18
 //
 // Copyright (C) 2007-2020 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -15,48 +15,68 @@
 #define VECTORS_H_DEF
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 
+// constexpr for the operations that can be evaluated at compile time
+// Multi-statement constexpr functions need C++14; older compilers get plain
+// inline functions, and the compile-time tables (see Profiles.h) are disabled
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define MATH_HAS_CONSTEXPR  1
+#define MATH_CONSTEXPR      constexpr
+#else
+#define MATH_HAS_CONSTEXPR  0
+#define MATH_CONSTEXPR      inline
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // 2D vector
 ///////////////////////////////////////////////////////////////////////////////
-struct Vector2
+template<typename T>
+struct Vector2T
 {
-    float x;
-    float y;
+    T x;
+    T y;
 
     // ctors
-    Vector2() : x(0), y(0) {};
-    Vector2(float x, float y) : x(x), y(y) {};
+    MATH_CONSTEXPR Vector2T() : x(0), y(0) {};
+    MATH_CONSTEXPR Vector2T(T x, T y) : x(x), y(y) {};
+    template<typename U>
+    MATH_CONSTEXPR explicit Vector2T(const Vector2T<U>& vec) : x(T(vec.x)), y(T(vec.y)) {}; // convert scalar type
 
     // utils functions
-    Vector2&    set(float x, float y);
-    float       length() const;                         //
-    float       distance(const Vector2& vec) const;     // distance between two vectors
-    Vector2&    normalize();                            //
-    float       dot(const Vector2& vec) const;          // dot product
-    bool        equal(const Vector2& vec, float e) const; // compare with epsilon
+    MATH_CONSTEXPR Vector2T&   set(T x, T y);
+    inline         T           length() const;                         //
+    inline         T           distance(const Vector2T& vec) const;    // distance between two vectors
+    inline         Vector2T&   normalize();                            //
+    MATH_CONSTEXPR T           dot(const Vector2T& vec) const;         // dot product
+    inline         bool        equal(const Vector2T& vec, T e) const;  // compare with epsilon
 
     // operators
-    Vector2     operator-() const;                      // unary operator (negate)
-    Vector2     operator+(const Vector2& rhs) const;    // add rhs
-    Vector2     operator-(const Vector2& rhs) const;    // subtract rhs
-    Vector2&    operator+=(const Vector2& rhs);         // add rhs and update this object
-    Vector2&    operator-=(const Vector2& rhs);         // subtract rhs and update this object
-    Vector2     operator*(const float scale) const;     // scale
-    Vector2     operator*(const Vector2& rhs) const;    // multiply each element
-    Vector2&    operator*=(const float scale);          // scale and update this object
-    Vector2&    operator*=(const Vector2& rhs);         // multiply each element and update this object
-    Vector2     operator/(const float scale) const;     // inverse scale
-    Vector2&    operator/=(const float scale);          // scale and update this object
-    bool        operator==(const Vector2& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Vector2& rhs) const;   // exact compare, no epsilon
-    bool        operator<(const Vector2& rhs) const;    // comparison for sort
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    friend Vector2 operator*(const float a, const Vector2 vec);
-    friend std::ostream& operator<<(std::ostream& os, const Vector2& vec);
+    MATH_CONSTEXPR Vector2T    operator-() const;                      // unary operator (negate)
+    MATH_CONSTEXPR Vector2T    operator+(const Vector2T& rhs) const;   // add rhs
+    MATH_CONSTEXPR Vector2T    operator-(const Vector2T& rhs) const;   // subtract rhs
+    MATH_CONSTEXPR Vector2T&   operator+=(const Vector2T& rhs);        // add rhs and update this object
+    MATH_CONSTEXPR Vector2T&   operator-=(const Vector2T& rhs);        // subtract rhs and update this object
+    MATH_CONSTEXPR Vector2T    operator*(const T scale) const;         // scale
+    MATH_CONSTEXPR Vector2T    operator*(const Vector2T& rhs) const;   // multiply each element
+    MATH_CONSTEXPR Vector2T&   operator*=(const T scale);              // scale and update this object
+    MATH_CONSTEXPR Vector2T&   operator*=(const Vector2T& rhs);        // multiply each element and update this object
+    MATH_CONSTEXPR Vector2T    operator/(const T scale) const;         // inverse scale
+    MATH_CONSTEXPR Vector2T&   operator/=(const T scale);              // scale and update this object
+    MATH_CONSTEXPR bool        operator==(const Vector2T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator!=(const Vector2T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator<(const Vector2T& rhs) const;   // comparison for sort
+    inline         T           operator[](int index) const;            // subscript operator v[0], v[1]
+    inline         T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    friend MATH_CONSTEXPR Vector2T operator*(const T a, const Vector2T& vec) {
+        return Vector2T(a*vec.x, a*vec.y);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Vector2T& vec) {
+        os << "(" << vec.x << ", " << vec.y << ")";
+        return os;
+    }
 };
 
 
@@ -64,46 +84,54 @@ struct Vector2
 ///////////////////////////////////////////////////////////////////////////////
 // 3D vector
 ///////////////////////////////////////////////////////////////////////////////
-struct Vector3
+template<typename T>
+struct Vector3T
 {
-    float x;
-    float y;
-    float z;
+    T x;
+    T y;
+    T z;
 
     // ctors
-    Vector3() : x(0), y(0), z(0) {};
-    Vector3(float x, float y, float z) : x(x), y(y), z(z) {};
+    MATH_CONSTEXPR Vector3T() : x(0), y(0), z(0) {};
+    MATH_CONSTEXPR Vector3T(T x, T y, T z) : x(x), y(y), z(z) {};
+    template<typename U>
+    MATH_CONSTEXPR explicit Vector3T(const Vector3T<U>& vec) : x(T(vec.x)), y(T(vec.y)), z(T(vec.z)) {}; // convert scalar type
 
     // utils functions
-    Vector3&    set(float x, float y, float z);
-    float       length() const;                         //
-    float       distance(const Vector3& vec) const;     // distance between two vectors
-    float       angle(const Vector3& vec) const;        // angle between two vectors
-    Vector3&    normalize();                            //
-    float       dot(const Vector3& vec) const;          // dot product
-    Vector3     cross(const Vector3& vec) const;        // cross product
-    bool        equal(const Vector3& vec, float e) const; // compare with epsilon
+    MATH_CONSTEXPR Vector3T&   set(T x, T y, T z);
+    inline         T           length() const;                         //
+    inline         T           distance(const Vector3T& vec) const;    // distance between two vectors
+    inline         T           angle(const Vector3T& vec) const;       // angle between two vectors
+    inline         Vector3T&   normalize();                            //
+    MATH_CONSTEXPR T           dot(const Vector3T& vec) const;         // dot product
+    MATH_CONSTEXPR Vector3T    cross(const Vector3T& vec) const;       // cross product
+    inline         bool        equal(const Vector3T& vec, T e) const;  // compare with epsilon
 
     // operators
-    Vector3     operator-() const;                      // unary operator (negate)
-    Vector3     operator+(const Vector3& rhs) const;    // add rhs
-    Vector3     operator-(const Vector3& rhs) const;    // subtract rhs
-    Vector3&    operator+=(const Vector3& rhs);         // add rhs and update this object
-    Vector3&    operator-=(const Vector3& rhs);         // subtract rhs and update this object
-    Vector3     operator*(const float scale) const;     // scale
-    Vector3     operator*(const Vector3& rhs) const;    // multiplay each element
-    Vector3&    operator*=(const float scale);          // scale and update this object
-    Vector3&    operator*=(const Vector3& rhs);         // product each element and update this object
-    Vector3     operator/(const float scale) const;     // inverse scale
-    Vector3&    operator/=(const float scale);          // scale and update this object
-    bool        operator==(const Vector3& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Vector3& rhs) const;   // exact compare, no epsilon
-    bool        operator<(const Vector3& rhs) const;    // comparison for sort
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    friend Vector3 operator*(const float a, const Vector3 vec);
-    friend std::ostream& operator<<(std::ostream& os, const Vector3& vec);
+    MATH_CONSTEXPR Vector3T    operator-() const;                      // unary operator (negate)
+    MATH_CONSTEXPR Vector3T    operator+(const Vector3T& rhs) const;   // add rhs
+    MATH_CONSTEXPR Vector3T    operator-(const Vector3T& rhs) const;   // subtract rhs
+    MATH_CONSTEXPR Vector3T&   operator+=(const Vector3T& rhs);        // add rhs and update this object
+    MATH_CONSTEXPR Vector3T&   operator-=(const Vector3T& rhs);        // subtract rhs and update this object
+    MATH_CONSTEXPR Vector3T    operator*(const T scale) const;         // scale
+    MATH_CONSTEXPR Vector3T    operator*(const Vector3T& rhs) const;   // multiplay each element
+    MATH_CONSTEXPR Vector3T&   operator*=(const T scale);              // scale and update this object
+    MATH_CONSTEXPR Vector3T&   operator*=(const Vector3T& rhs);        // product each element and update this object
+    MATH_CONSTEXPR Vector3T    operator/(const T scale) const;         // inverse scale
+    MATH_CONSTEXPR Vector3T&   operator/=(const T scale);              // scale and update this object
+    MATH_CONSTEXPR bool        operator==(const Vector3T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator!=(const Vector3T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator<(const Vector3T& rhs) const;   // comparison for sort
+    inline         T           operator[](int index) const;            // subscript operator v[0], v[1]
+    inline         T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    friend MATH_CONSTEXPR Vector3T operator*(const T a, const Vector3T& vec) {
+        return Vector3T(a*vec.x, a*vec.y, a*vec.z);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Vector3T& vec) {
+        os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")";
+        return os;
+    }
 };
 
 
@@ -111,118 +139,223 @@ struct Vector3
 ///////////////////////////////////////////////////////////////////////////////
 // 4D vector
 ///////////////////////////////////////////////////////////////////////////////
-struct Vector4
+template<typename T>
+struct Vector4T
 {
-    float x;
-    float y;
-    float z;
-    float w;
+    T x;
+    T y;
+    T z;
+    T w;
 
     // ctors
-    Vector4() : x(0), y(0), z(0), w(0) {};
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {};
+    MATH_CONSTEXPR Vector4T() : x(0), y(0), z(0), w(0) {};
+    MATH_CONSTEXPR Vector4T(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {};
+    template<typename U>
+    MATH_CONSTEXPR explicit Vector4T(const Vector4T<U>& vec) : x(T(vec.x)), y(T(vec.y)), z(T(vec.z)), w(T(vec.w)) {}; // convert scalar type
 
     // utils functions
-    Vector4&    set(float x, float y, float z, float w);
-    float       length() const;                         //
-    float       distance(const Vector4& vec) const;     // distance between two vectors
-    Vector4&    normalize();                            //
-    float       dot(const Vector4& vec) const;          // dot product
-    bool        equal(const Vector4& vec, float e) const; // compare with epsilon
+    MATH_CONSTEXPR Vector4T&   set(T x, T y, T z, T w);
+    inline         T           length() const;                         //
+    inline         T           distance(const Vector4T& vec) const;    // distance between two vectors
+    inline         Vector4T&   normalize();                            //
+    MATH_CONSTEXPR T           dot(const Vector4T& vec) const;         // dot product
+    inline         bool        equal(const Vector4T& vec, T e) const;  // compare with epsilon
 
     // operators
-    Vector4     operator-() const;                      // unary operator (negate)
-    Vector4     operator+(const Vector4& rhs) const;    // add rhs
-    Vector4     operator-(const Vector4& rhs) const;    // subtract rhs
-    Vector4&    operator+=(const Vector4& rhs);         // add rhs and update this object
-    Vector4&    operator-=(const Vector4& rhs);         // subtract rhs and update this object
-    Vector4     operator*(const float scale) const;     // scale
-    Vector4     operator*(const Vector4& rhs) const;    // multiply each element
-    Vector4&    operator*=(const float scale);          // scale and update this object
-    Vector4&    operator*=(const Vector4& rhs);         // multiply each element and update this object
-    Vector4     operator/(const float scale) const;     // inverse scale
-    Vector4&    operator/=(const float scale);          // scale and update this object
-    bool        operator==(const Vector4& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Vector4& rhs) const;   // exact compare, no epsilon
-    bool        operator<(const Vector4& rhs) const;    // comparison for sort
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    friend Vector4 operator*(const float a, const Vector4 vec);
-    friend std::ostream& operator<<(std::ostream& os, const Vector4& vec);
+    MATH_CONSTEXPR Vector4T    operator-() const;                      // unary operator (negate)
+    MATH_CONSTEXPR Vector4T    operator+(const Vector4T& rhs) const;   // add rhs
+    MATH_CONSTEXPR Vector4T    operator-(const Vector4T& rhs) const;   // subtract rhs
+    MATH_CONSTEXPR Vector4T&   operator+=(const Vector4T& rhs);        // add rhs and update this object
+    MATH_CONSTEXPR Vector4T&   operator-=(const Vector4T& rhs);        // subtract rhs and update this object
+    MATH_CONSTEXPR Vector4T    operator*(const T scale) const;         // scale
+    MATH_CONSTEXPR Vector4T    operator*(const Vector4T& rhs) const;   // multiply each element
+    MATH_CONSTEXPR Vector4T&   operator*=(const T scale);              // scale and update this object
+    MATH_CONSTEXPR Vector4T&   operator*=(const Vector4T& rhs);        // multiply each element and update this object
+    MATH_CONSTEXPR Vector4T    operator/(const T scale) const;         // inverse scale
+    MATH_CONSTEXPR Vector4T&   operator/=(const T scale);              // scale and update this object
+    MATH_CONSTEXPR bool        operator==(const Vector4T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator!=(const Vector4T& rhs) const;  // exact compare, no epsilon
+    MATH_CONSTEXPR bool        operator<(const Vector4T& rhs) const;   // comparison for sort
+    inline         T           operator[](int index) const;            // subscript operator v[0], v[1]
+    inline         T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    friend MATH_CONSTEXPR Vector4T operator*(const T a, const Vector4T& vec) {
+        return Vector4T(a*vec.x, a*vec.y, a*vec.z, a*vec.w);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Vector4T& vec) {
+        os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ", " << vec.w << ")";
+        return os;
+    }
 };
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// aliases for single and double precision
+///////////////////////////////////////////////////////////////////////////////
+typedef Vector2T<float>  Vector2;
+typedef Vector3T<float>  Vector3;
+typedef Vector4T<float>  Vector4;
+typedef Vector2T<double> Vector2d;
+typedef Vector3T<double> Vector3d;
+typedef Vector4T<double> Vector4d;
+
+
+
 // fast math routines from Doom3 SDK
 inline float invSqrt(float x)
 {
     float xhalf = 0.5f * x;
-    int i = *(int*)&x;          // get bits for floating value
-    i = 0x5f3759df - (i>>1);    // gives initial guess
-    x = *(float*)&i;            // convert bits back to float
-    x = x * (1.5f - xhalf*x*x); // Newton step
+    int i;
+    std::memcpy(&i, &x, sizeof(i)); // get bits for floating value
+    i = 0x5f3759df - (i>>1);        // gives initial guess
+    std::memcpy(&x, &i, sizeof(x)); // convert bits back to float
+    x = x * (1.5f - xhalf*x*x);     // Newton step
+    return x;
+}
+
+// same for double with 64-bit magic number and 2 Newton steps
+inline double invSqrt(double x)
+{
+    double xhalf = 0.5 * x;
+    long long i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5fe6eb50c7b537a9LL - (i>>1);
+    std::memcpy(&x, &i, sizeof(x));
+    x = x * (1.5 - xhalf*x*x);
+    x = x * (1.5 - xhalf*x*x);
     return x;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// inline functions for Vector2
+// precision policy of 1/sqrt(x) for normalize() and the ring normal kernels
+// Select it at compile time with -DVECTORS_PRECISION=<mode>; it must be the
+// same for every translation unit. Max relative errors measured over
+// [1e-3, 1e3]:
+//
+// VECTORS_PRECISION_EXACT: 1 / sqrt(x), correctly rounded sqrt and division
+//                          float < 9e-8, double < 2.3e-16 (default)
+// VECTORS_PRECISION_FAST : invSqrt(), magic number and Newton step(s)
+//                          float < 1.8e-3 (1 step), double < 4.7e-6 (2 steps)
+// VECTORS_PRECISION_RSQRT: SSE rsqrtss (|error| <= 1.5*2^-12) + Newton step
+//                          float < 3e-7; double uses EXACT, non-x86 uses FAST
+//
+// FAST is good enough for shading normals only; it also affects lookAt() and
+// every other caller of normalize(), so keep EXACT where geometry matters.
+//
+// VectorsTest.cpp checks these bounds: make -f Makefile.linux selftest
 ///////////////////////////////////////////////////////////////////////////////
-inline Vector2 Vector2::operator-() const {
-    return Vector2(-x, -y);
+#define VECTORS_PRECISION_EXACT     0
+#define VECTORS_PRECISION_FAST      1
+#define VECTORS_PRECISION_RSQRT     2
+
+#ifndef VECTORS_PRECISION
+#define VECTORS_PRECISION VECTORS_PRECISION_EXACT
+#endif
+
+#if VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && (defined(__SSE__) || defined(_M_X64))
+#define VECTORS_HAS_RSQRT 1
+#include <xmmintrin.h>
+#else
+#define VECTORS_HAS_RSQRT 0
+#endif
+
+// inverse square root with the selected precision policy
+inline float inverseSqrt(float x)
+{
+#if VECTORS_HAS_RSQRT
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f*x*y*y); // Newton step
+#elif VECTORS_PRECISION == VECTORS_PRECISION_EXACT
+    return 1.0f / std::sqrt(x);
+#else
+    return invSqrt(x);
+#endif
 }
 
-inline Vector2 Vector2::operator+(const Vector2& rhs) const {
-    return Vector2(x+rhs.x, y+rhs.y);
+inline double inverseSqrt(double x)
+{
+#if VECTORS_PRECISION == VECTORS_PRECISION_FAST || (VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && !VECTORS_HAS_RSQRT)
+    return invSqrt(x);
+#else
+    return 1.0 / std::sqrt(x);
+#endif
 }
 
-inline Vector2 Vector2::operator-(const Vector2& rhs) const {
-    return Vector2(x-rhs.x, y-rhs.y);
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions for Vector2T
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Vector2T<T>::operator-() const {
+    return Vector2T<T>(-x, -y);
 }
 
-inline Vector2& Vector2::operator+=(const Vector2& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Vector2T<T>::operator+(const Vector2T<T>& rhs) const {
+    return Vector2T<T>(x+rhs.x, y+rhs.y);
+}
+
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Vector2T<T>::operator-(const Vector2T<T>& rhs) const {
+    return Vector2T<T>(x-rhs.x, y-rhs.y);
+}
+
+template<typename T>
+MATH_CONSTEXPR Vector2T<T>& Vector2T<T>::operator+=(const Vector2T<T>& rhs) {
     x += rhs.x; y += rhs.y; return *this;
 }
 
-inline Vector2& Vector2::operator-=(const Vector2& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector2T<T>& Vector2T<T>::operator-=(const Vector2T<T>& rhs) {
     x -= rhs.x; y -= rhs.y; return *this;
 }
 
-inline Vector2 Vector2::operator*(const float a) const {
-    return Vector2(x*a, y*a);
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Vector2T<T>::operator*(const T a) const {
+    return Vector2T<T>(x*a, y*a);
 }
 
-inline Vector2 Vector2::operator*(const Vector2& rhs) const {
-    return Vector2(x*rhs.x, y*rhs.y);
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Vector2T<T>::operator*(const Vector2T<T>& rhs) const {
+    return Vector2T<T>(x*rhs.x, y*rhs.y);
 }
 
-inline Vector2& Vector2::operator*=(const float a) {
+template<typename T>
+MATH_CONSTEXPR Vector2T<T>& Vector2T<T>::operator*=(const T a) {
     x *= a; y *= a; return *this;
 }
 
-inline Vector2& Vector2::operator*=(const Vector2& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector2T<T>& Vector2T<T>::operator*=(const Vector2T<T>& rhs) {
     x *= rhs.x; y *= rhs.y; return *this;
 }
 
-inline Vector2 Vector2::operator/(const float a) const {
-    return Vector2(x/a, y/a);
+template<typename T>
+MATH_CONSTEXPR Vector2T<T> Vector2T<T>::operator/(const T a) const {
+    return Vector2T<T>(x/a, y/a);
 }
 
-inline Vector2& Vector2::operator/=(const float a) {
+template<typename T>
+MATH_CONSTEXPR Vector2T<T>& Vector2T<T>::operator/=(const T a) {
     x /= a; y /= a; return *this;
 }
 
-inline bool Vector2::operator==(const Vector2& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector2T<T>::operator==(const Vector2T<T>& rhs) const {
     return (x == rhs.x) && (y == rhs.y);
 }
 
-inline bool Vector2::operator!=(const Vector2& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector2T<T>::operator!=(const Vector2T<T>& rhs) const {
     return (x != rhs.x) || (y != rhs.y);
 }
 
-inline bool Vector2::operator<(const Vector2& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector2T<T>::operator<(const Vector2T<T>& rhs) const {
     if(x < rhs.x) return true;
     if(x > rhs.x) return false;
     if(y < rhs.y) return true;
@@ -230,54 +363,52 @@ inline bool Vector2::operator<(const Vector2& rhs) const {
     return false;
 }
 
-inline float Vector2::operator[](int index) const {
+template<typename T>
+inline T Vector2T<T>::operator[](int index) const {
     return (&x)[index];
 }
 
-inline float& Vector2::operator[](int index) {
+template<typename T>
+inline T& Vector2T<T>::operator[](int index) {
     return (&x)[index];
 }
 
-inline Vector2& Vector2::set(float x, float y) {
+template<typename T>
+MATH_CONSTEXPR Vector2T<T>& Vector2T<T>::set(T x, T y) {
     this->x = x; this->y = y; return *this;
 }
 
-inline float Vector2::length() const {
-    return sqrtf(x*x + y*y);
+template<typename T>
+inline T Vector2T<T>::length() const {
+    return std::sqrt(x*x + y*y);
 }
 
-inline float Vector2::distance(const Vector2& vec) const {
-    return sqrtf((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y));
+template<typename T>
+inline T Vector2T<T>::distance(const Vector2T<T>& vec) const {
+    return std::sqrt((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y));
 }
 
-inline Vector2& Vector2::normalize() {
-    //@@const float EPSILON = 0.000001f;
-    float xxyy = x*x + y*y;
+template<typename T>
+inline Vector2T<T>& Vector2T<T>::normalize() {
+    //@@const T EPSILON = T(0.000001);
+    T xxyy = x*x + y*y;
     //@@if(xxyy < EPSILON)
     //@@    return *this;
 
-    //float invLength = invSqrt(xxyy);
-    float invLength = 1.0f / sqrtf(xxyy);
+    T invLength = inverseSqrt(xxyy);
     x *= invLength;
     y *= invLength;
     return *this;
 }
 
-inline float Vector2::dot(const Vector2& rhs) const {
+template<typename T>
+MATH_CONSTEXPR T Vector2T<T>::dot(const Vector2T<T>& rhs) const {
     return (x*rhs.x + y*rhs.y);
 }
 
-inline bool Vector2::equal(const Vector2& rhs, float epsilon) const {
-    return fabs(x - rhs.x) < epsilon && fabs(y - rhs.y) < epsilon;
-}
-
-inline Vector2 operator*(const float a, const Vector2 vec) {
-    return Vector2(a*vec.x, a*vec.y);
-}
-
-inline std::ostream& operator<<(std::ostream& os, const Vector2& vec) {
-    os << "(" << vec.x << ", " << vec.y << ")";
-    return os;
+template<typename T>
+inline bool Vector2T<T>::equal(const Vector2T<T>& rhs, T epsilon) const {
+    return std::fabs(x - rhs.x) < epsilon && std::fabs(y - rhs.y) < epsilon;
 }
 // END OF VECTOR2 /////////////////////////////////////////////////////////////
 
@@ -285,61 +416,75 @@ inline std::ostream& operator<<(std::ostream& os, const Vector2& vec) {
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// inline functions for Vector3
+// inline functions for Vector3T
 ///////////////////////////////////////////////////////////////////////////////
-inline Vector3 Vector3::operator-() const {
-    return Vector3(-x, -y, -z);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::operator-() const {
+    return Vector3T<T>(-x, -y, -z);
 }
 
-inline Vector3 Vector3::operator+(const Vector3& rhs) const {
-    return Vector3(x+rhs.x, y+rhs.y, z+rhs.z);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::operator+(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(x+rhs.x, y+rhs.y, z+rhs.z);
 }
 
-inline Vector3 Vector3::operator-(const Vector3& rhs) const {
-    return Vector3(x-rhs.x, y-rhs.y, z-rhs.z);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::operator-(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(x-rhs.x, y-rhs.y, z-rhs.z);
 }
 
-inline Vector3& Vector3::operator+=(const Vector3& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector3T<T>& Vector3T<T>::operator+=(const Vector3T<T>& rhs) {
     x += rhs.x; y += rhs.y; z += rhs.z; return *this;
 }
 
-inline Vector3& Vector3::operator-=(const Vector3& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector3T<T>& Vector3T<T>::operator-=(const Vector3T<T>& rhs) {
     x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this;
 }
 
-inline Vector3 Vector3::operator*(const float a) const {
-    return Vector3(x*a, y*a, z*a);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::operator*(const T a) const {
+    return Vector3T<T>(x*a, y*a, z*a);
 }
 
-inline Vector3 Vector3::operator*(const Vector3& rhs) const {
-    return Vector3(x*rhs.x, y*rhs.y, z*rhs.z);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::operator*(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(x*rhs.x, y*rhs.y, z*rhs.z);
 }
 
-inline Vector3& Vector3::operator*=(const float a) {
+template<typename T>
+MATH_CONSTEXPR Vector3T<T>& Vector3T<T>::operator*=(const T a) {
     x *= a; y *= a; z *= a; return *this;
 }
 
-inline Vector3& Vector3::operator*=(const Vector3& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector3T<T>& Vector3T<T>::operator*=(const Vector3T<T>& rhs) {
     x *= rhs.x; y *= rhs.y; z *= rhs.z; return *this;
 }
 
-inline Vector3 Vector3::operator/(const float a) const {
-    return Vector3(x/a, y/a, z/a);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::operator/(const T a) const {
+    return Vector3T<T>(x/a, y/a, z/a);
 }
 
-inline Vector3& Vector3::operator/=(const float a) {
+template<typename T>
+MATH_CONSTEXPR Vector3T<T>& Vector3T<T>::operator/=(const T a) {
     x /= a; y /= a; z /= a; return *this;
 }
 
-inline bool Vector3::operator==(const Vector3& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector3T<T>::operator==(const Vector3T<T>& rhs) const {
     return (x == rhs.x) && (y == rhs.y) && (z == rhs.z);
 }
 
-inline bool Vector3::operator!=(const Vector3& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector3T<T>::operator!=(const Vector3T<T>& rhs) const {
     return (x != rhs.x) || (y != rhs.y) || (z != rhs.z);
 }
 
-inline bool Vector3::operator<(const Vector3& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector3T<T>::operator<(const Vector3T<T>& rhs) const {
     if(x < rhs.x) return true;
     if(x > rhs.x) return false;
     if(y < rhs.y) return true;
@@ -349,129 +494,143 @@ inline bool Vector3::operator<(const Vector3& rhs) const {
     return false;
 }
 
-inline float Vector3::operator[](int index) const {
+template<typename T>
+inline T Vector3T<T>::operator[](int index) const {
     return (&x)[index];
 }
 
-inline float& Vector3::operator[](int index) {
+template<typename T>
+inline T& Vector3T<T>::operator[](int index) {
     return (&x)[index];
 }
 
-inline Vector3& Vector3::set(float x, float y, float z) {
+template<typename T>
+MATH_CONSTEXPR Vector3T<T>& Vector3T<T>::set(T x, T y, T z) {
     this->x = x; this->y = y; this->z = z; return *this;
 }
 
-inline float Vector3::length() const {
-    return sqrtf(x*x + y*y + z*z);
+template<typename T>
+inline T Vector3T<T>::length() const {
+    return std::sqrt(x*x + y*y + z*z);
 }
 
-inline float Vector3::distance(const Vector3& vec) const {
-    return sqrtf((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y) + (vec.z-z)*(vec.z-z));
+template<typename T>
+inline T Vector3T<T>::distance(const Vector3T<T>& vec) const {
+    return std::sqrt((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y) + (vec.z-z)*(vec.z-z));
 }
 
-inline float Vector3::angle(const Vector3& vec) const {
+template<typename T>
+inline T Vector3T<T>::angle(const Vector3T<T>& vec) const {
     // return angle between [0, 180]
-    float l1 = this->length();
-    float l2 = vec.length();
-    float d = this->dot(vec);
-    float angle = acosf(d / (l1 * l2)) / 3.141592f * 180.0f;
+    T l1 = this->length();
+    T l2 = vec.length();
+    T d = this->dot(vec);
+    T angle = std::acos(d / (l1 * l2)) / T(3.141592653589793) * T(180);
     return angle;
 }
 
-inline Vector3& Vector3::normalize() {
-    //@@const float EPSILON = 0.000001f;
-    float xxyyzz = x*x + y*y + z*z;
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::normalize() {
+    //@@const T EPSILON = T(0.000001);
+    T xxyyzz = x*x + y*y + z*z;
     //@@if(xxyyzz < EPSILON)
     //@@    return *this; // do nothing if it is ~zero vector
 
-    //float invLength = invSqrt(xxyyzz);
-    float invLength = 1.0f / sqrtf(xxyyzz);
+    T invLength = inverseSqrt(xxyyzz);
     x *= invLength;
     y *= invLength;
     z *= invLength;
     return *this;
 }
 
-inline float Vector3::dot(const Vector3& rhs) const {
+template<typename T>
+MATH_CONSTEXPR T Vector3T<T>::dot(const Vector3T<T>& rhs) const {
     return (x*rhs.x + y*rhs.y + z*rhs.z);
 }
 
-inline Vector3 Vector3::cross(const Vector3& rhs) const {
-    return Vector3(y*rhs.z - z*rhs.y, z*rhs.x - x*rhs.z, x*rhs.y - y*rhs.x);
-}
-
-inline bool Vector3::equal(const Vector3& rhs, float epsilon) const {
-    return fabs(x - rhs.x) < epsilon && fabs(y - rhs.y) < epsilon && fabs(z - rhs.z) < epsilon;
-}
-
-inline Vector3 operator*(const float a, const Vector3 vec) {
-    return Vector3(a*vec.x, a*vec.y, a*vec.z);
+template<typename T>
+MATH_CONSTEXPR Vector3T<T> Vector3T<T>::cross(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(y*rhs.z - z*rhs.y, z*rhs.x - x*rhs.z, x*rhs.y - y*rhs.x);
 }
 
-inline std::ostream& operator<<(std::ostream& os, const Vector3& vec) {
-    os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")";
-    return os;
+template<typename T>
+inline bool Vector3T<T>::equal(const Vector3T<T>& rhs, T epsilon) const {
+    return std::fabs(x - rhs.x) < epsilon && std::fabs(y - rhs.y) < epsilon && std::fabs(z - rhs.z) < epsilon;
 }
 // END OF VECTOR3 /////////////////////////////////////////////////////////////
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// inline functions for Vector4
+// inline functions for Vector4T
 ///////////////////////////////////////////////////////////////////////////////
-inline Vector4 Vector4::operator-() const {
-    return Vector4(-x, -y, -z, -w);
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Vector4T<T>::operator-() const {
+    return Vector4T<T>(-x, -y, -z, -w);
 }
 
-inline Vector4 Vector4::operator+(const Vector4& rhs) const {
-    return Vector4(x+rhs.x, y+rhs.y, z+rhs.z, w+rhs.w);
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Vector4T<T>::operator+(const Vector4T<T>& rhs) const {
+    return Vector4T<T>(x+rhs.x, y+rhs.y, z+rhs.z, w+rhs.w);
 }
 
-inline Vector4 Vector4::operator-(const Vector4& rhs) const {
-    return Vector4(x-rhs.x, y-rhs.y, z-rhs.z, w-rhs.w);
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Vector4T<T>::operator-(const Vector4T<T>& rhs) const {
+    return Vector4T<T>(x-rhs.x, y-rhs.y, z-rhs.z, w-rhs.w);
 }
 
-inline Vector4& Vector4::operator+=(const Vector4& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector4T<T>& Vector4T<T>::operator+=(const Vector4T<T>& rhs) {
     x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w; return *this;
 }
 
-inline Vector4& Vector4::operator-=(const Vector4& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector4T<T>& Vector4T<T>::operator-=(const Vector4T<T>& rhs) {
     x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this;
 }
 
-inline Vector4 Vector4::operator*(const float a) const {
-    return Vector4(x*a, y*a, z*a, w*a);
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Vector4T<T>::operator*(const T a) const {
+    return Vector4T<T>(x*a, y*a, z*a, w*a);
 }
 
-inline Vector4 Vector4::operator*(const Vector4& rhs) const {
-    return Vector4(x*rhs.x, y*rhs.y, z*rhs.z, w*rhs.w);
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Vector4T<T>::operator*(const Vector4T<T>& rhs) const {
+    return Vector4T<T>(x*rhs.x, y*rhs.y, z*rhs.z, w*rhs.w);
 }
 
-inline Vector4& Vector4::operator*=(const float a) {
+template<typename T>
+MATH_CONSTEXPR Vector4T<T>& Vector4T<T>::operator*=(const T a) {
     x *= a; y *= a; z *= a; w *= a; return *this;
 }
 
-inline Vector4& Vector4::operator*=(const Vector4& rhs) {
+template<typename T>
+MATH_CONSTEXPR Vector4T<T>& Vector4T<T>::operator*=(const Vector4T<T>& rhs) {
     x *= rhs.x; y *= rhs.y; z *= rhs.z; w *= rhs.w; return *this;
 }
 
-inline Vector4 Vector4::operator/(const float a) const {
-    return Vector4(x/a, y/a, z/a, w/a);
+template<typename T>
+MATH_CONSTEXPR Vector4T<T> Vector4T<T>::operator/(const T a) const {
+    return Vector4T<T>(x/a, y/a, z/a, w/a);
 }
 
-inline Vector4& Vector4::operator/=(const float a) {
+template<typename T>
+MATH_CONSTEXPR Vector4T<T>& Vector4T<T>::operator/=(const T a) {
     x /= a; y /= a; z /= a; w /= a; return *this;
 }
 
-inline bool Vector4::operator==(const Vector4& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector4T<T>::operator==(const Vector4T<T>& rhs) const {
     return (x == rhs.x) && (y == rhs.y) && (z == rhs.z) && (w == rhs.w);
 }
 
-inline bool Vector4::operator!=(const Vector4& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector4T<T>::operator!=(const Vector4T<T>& rhs) const {
     return (x != rhs.x) || (y != rhs.y) || (z != rhs.z) || (w != rhs.w);
 }
 
-inline bool Vector4::operator<(const Vector4& rhs) const {
+template<typename T>
+MATH_CONSTEXPR bool Vector4T<T>::operator<(const Vector4T<T>& rhs) const {
     if(x < rhs.x) return true;
     if(x > rhs.x) return false;
     if(y < rhs.y) return true;
@@ -483,57 +642,55 @@ inline bool Vector4::operator<(const Vector4& rhs) const {
     return false;
 }
 
-inline float Vector4::operator[](int index) const {
+template<typename T>
+inline T Vector4T<T>::operator[](int index) const {
     return (&x)[index];
 }
 
-inline float& Vector4::operator[](int index) {
+template<typename T>
+inline T& Vector4T<T>::operator[](int index) {
     return (&x)[index];
 }
 
-inline Vector4& Vector4::set(float x, float y, float z, float w) {
+template<typename T>
+MATH_CONSTEXPR Vector4T<T>& Vector4T<T>::set(T x, T y, T z, T w) {
     this->x = x; this->y = y; this->z = z; this->w = w; return *this;
 }
 
-inline float Vector4::length() const {
-    return sqrtf(x*x + y*y + z*z + w*w);
+template<typename T>
+inline T Vector4T<T>::length() const {
+    return std::sqrt(x*x + y*y + z*z + w*w);
 }
 
-inline float Vector4::distance(const Vector4& vec) const {
-    return sqrtf((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y) + (vec.z-z)*(vec.z-z) + (vec.w-w)*(vec.w-w));
+template<typename T>
+inline T Vector4T<T>::distance(const Vector4T<T>& vec) const {
+    return std::sqrt((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y) + (vec.z-z)*(vec.z-z) + (vec.w-w)*(vec.w-w));
 }
 
-inline Vector4& Vector4::normalize() {
+template<typename T>
+inline Vector4T<T>& Vector4T<T>::normalize() {
     //NOTE: leave w-component untouched
-    //@@const float EPSILON = 0.000001f;
-    float xxyyzz = x*x + y*y + z*z;
+    //@@const T EPSILON = T(0.000001);
+    T xxyyzz = x*x + y*y + z*z;
     //@@if(xxyyzz < EPSILON)
     //@@    return *this; // do nothing if it is zero vector
 
-    //float invLength = invSqrt(xxyyzz);
-    float invLength = 1.0f / sqrtf(xxyyzz);
+    T invLength = inverseSqrt(xxyyzz);
     x *= invLength;
     y *= invLength;
     z *= invLength;
     return *this;
 }
 
-inline float Vector4::dot(const Vector4& rhs) const {
+template<typename T>
+MATH_CONSTEXPR T Vector4T<T>::dot(const Vector4T<T>& rhs) const {
     return (x*rhs.x + y*rhs.y + z*rhs.z + w*rhs.w);
 }
 
-inline bool Vector4::equal(const Vector4& rhs, float epsilon) const {
-    return fabs(x - rhs.x) < epsilon && fabs(y - rhs.y) < epsilon &&
-           fabs(z - rhs.z) < epsilon && fabs(w - rhs.w) < epsilon;
-}
-
-inline Vector4 operator*(const float a, const Vector4 vec) {
-    return Vector4(a*vec.x, a*vec.y, a*vec.z, a*vec.w);
-}
-
-inline std::ostream& operator<<(std::ostream& os, const Vector4& vec) {
-    os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ", " << vec.w << ")";
-    return os;
+template<typename T>
+inline bool Vector4T<T>::equal(const Vector4T<T>& rhs, T epsilon) const {
+    return std::fabs(x - rhs.x) < epsilon && std::fabs(y - rhs.y) < epsilon &&
+           std::fabs(z - rhs.z) < epsilon && std::fabs(w - rhs.w) < epsilon;
 }
 // END OF VECTOR4 /////////////////////////////////////////////////////////////
 
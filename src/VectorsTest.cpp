@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// VectorsTest.cpp
+// ===============
+// self test of the 1/sqrt(x) precision policy in Vectors.h
+// It measures the max relative error of inverseSqrt() and normalize() over
+// [1e-3, 1e3] and fails if it exceeds the bound documented in Vectors.h for
+// the policy it is compiled with. Build and run it for every policy with
+// "make -f Makefile.linux selftest".
+//
+// Dependencies: Vectors
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+#include "Vectors.h"
+
+// the bounds documented in Vectors.h; keep them in sync
+#if VECTORS_PRECISION == VECTORS_PRECISION_FAST || (VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && !VECTORS_HAS_RSQRT)
+const double MAX_ERROR_FLOAT  = 1.8e-3;
+const double MAX_ERROR_DOUBLE = 4.7e-6;
+#elif VECTORS_PRECISION == VECTORS_PRECISION_RSQRT
+const double MAX_ERROR_FLOAT  = 3e-7;
+const double MAX_ERROR_DOUBLE = 2.3e-16;
+#else
+const double MAX_ERROR_FLOAT  = 9e-8;
+const double MAX_ERROR_DOUBLE = 2.3e-16;
+#endif
+
+const double RANGE_MIN = 1e-3;
+const double RANGE_MAX = 1e3;
+const double STEP      = 1.000003;  // ratio between 2 samples, ~4.6M samples
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// max relative error of inverseSqrt() against long double 1/sqrt(x)
+// The float version is measured at x rounded to float.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+double measureInverseSqrt()
+{
+    double maxError = 0;
+    for(double x = RANGE_MIN; x < RANGE_MAX; x *= STEP)
+    {
+        T value = (T)x;
+        long double expected = 1.0L / std::sqrt((long double)value);
+        double error = (double)(std::fabs((long double)inverseSqrt(value) - expected) / expected);
+        if(error > maxError)
+            maxError = error;
+    }
+    return maxError;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// max error of the length of normalized vectors with the length in the range
+// The length is computed in long double, so only normalize() is measured.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+double measureNormalize()
+{
+    double maxError = 0;
+    for(double x = RANGE_MIN; x < RANGE_MAX; x *= STEP * STEP * STEP)
+    {
+        // components of length x, off the axes
+        double s = std::sqrt(x);
+        Vector3T<T> v((T)(s * 0.48), (T)(s * 0.6), (T)(s * 0.64));
+        v.normalize();
+        long double length = std::sqrt((long double)v.x * v.x + (long double)v.y * v.y + (long double)v.z * v.z);
+        double error = (double)std::fabs(length - 1.0L);
+        if(error > maxError)
+            maxError = error;
+    }
+    return maxError;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// normalize() adds the rounding of the squared length and of 3 products to
+// the error of inverseSqrt(), a few ulp of T
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+bool check(const char* name, double maxError, double ulp)
+{
+    double errorSqrt = measureInverseSqrt<T>();
+    double errorNormalize = measureNormalize<T>();
+    bool passed = (errorSqrt < maxError) && (errorNormalize < maxError + 4 * ulp);
+    std::printf("%-6s inverseSqrt: %.3g, normalize: %.3g, bound: %.3g  %s\n",
+                name, errorSqrt, errorNormalize, maxError, passed ? "OK" : "FAILED");
+    return passed;
+}
+
+
+
+int main()
+{
+    const char* policies[] = { "EXACT", "FAST", "RSQRT" };
+    std::printf("VECTORS_PRECISION_%s%s\n", policies[VECTORS_PRECISION],
+                (VECTORS_PRECISION == VECTORS_PRECISION_RSQRT && !VECTORS_HAS_RSQRT) ? " (no SSE, FAST)" : "");
+
+    bool passed = check<float>("float", MAX_ERROR_FLOAT, 5.96e-8);
+    passed = check<double>("double", MAX_ERROR_DOUBLE, 1.11e-16) && passed;
+    return passed ? 0 : 1;
+}
@@ -5,7 +5,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-04-12
-// UPDATED: 2020-02-29
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef __APPLE__
@@ -25,6 +25,11 @@
 #include "Plane.h"
 #include "Line.h"
 #include "Pipe.h"
+#include "PipeLod.h"
+#include "MemoryResource.h"
+#include "Timer.h"
+#include "Kernels.h"
+#include "Profiles.h"
 
 
 
@@ -52,10 +57,16 @@ void drawString(const char *str, int x, int y, float color[4], void *font);
 void drawString3D(const char *str, float pos[3], float color[4], void *font);
 void showInfo();
 void drawPipe();
+void drawRing(const Pipe::Contour& contour, const Pipe::Contour& normal);
 void drawPath();
 void draw();
+void updateChunks();
+void computeChunk(struct PipeChunk& chunk);
+void cullChunks(const Matrix4& matrix);
+void selectChunkLods(const Matrix4& view);
 std::vector<Vector3> buildSpiralPath(float r1, float r2, float h1, float h2, float turns, int points);
 std::vector<Vector3> buildCircle(float radius, int steps);
+void measureMemory(int ringCount);
 
 
 
@@ -63,6 +74,34 @@ std::vector<Vector3> buildCircle(float radius, int steps);
 const int SCREEN_WIDTH = 600;
 const int SCREEN_HEIGHT = 600;
 const int CIRCLE_SECTORS = 48;
+const float CAMERA_FOV = 60.0f;             // vertical field of view in degree
+const float CAMERA_NEAR = 1.0f;
+const float CAMERA_FAR = 1000.0f;
+
+// levels of detail
+// The pipe is split into chunks of rings, and each chunk picks the sector
+// count (level) and the ring step from the screen size of its error. A chunk
+// moves to a coarser choice only if it is within the error reduced by
+// LOD_HYSTERESIS, so it does not flip back and forth at the threshold.
+const int LOD_LEVEL_COUNT = 3;
+const int LOD_SECTORS[LOD_LEVEL_COUNT] = {CIRCLE_SECTORS, 12, 6};
+const int LOD_CHUNK_SIZE = 16;              // # of segments per chunk
+const int LOD_STEP_COUNT = 4;               // ring steps 1, 2, 4, 8
+const float LOD_PIXEL_ERROR = 0.5f;         // max screen error for each of sectors and rings
+const float LOD_HYSTERESIS = 0.25f;
+
+// run of rings of the pipe drawn with the same level of detail
+struct PipeChunk
+{
+    int first;                              // first ring
+    int count;                              // # of segments, rings [first, first+count]
+    Vector3 center;                         // bounding sphere
+    float radius;
+    float stepErrors[LOD_STEP_COUNT];       // max error of drawing every (1<<k)-th ring only
+    int level;                              // current level of detail
+    int step;                               // current ring step (log2)
+    bool visible;                           // inside the view frustum
+};
 
 // global variables
 void *font = GLUT_BITMAP_8_BY_13;
@@ -78,11 +117,23 @@ int currIndex = 0;
 bool animating = true;
 std::vector<Vector3> path;
 std::vector<Vector3> circle;
-Pipe pipe;
+std::vector<float> stripVertices;   // interleaved normal/vertex of a strip
+PipeLod pipeLod;                    // all levels of the pipe, no checkpoints, so
+                                    // getContour() never returns a released ring
+std::vector<PipeChunk> chunks;
+std::vector<float> chunkX, chunkY, chunkZ, chunkRadii;  // bounding spheres of chunks for culling
+std::vector<unsigned char> chunkMask;
+bool lodEnabled = true;
+bool cullingEnabled = true;
+int drawnTriangles;
+int visibleChunks;
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // draw a pipe
+// Only the chunks in the view frustum are drawn, each with its own level and
+// ring step. The rings shared by 2 chunks of different levels leave small
+// gaps, but they are within the screen error.
 ///////////////////////////////////////////////////////////////////////////////
 void drawPipe()
 {
@@ -95,40 +146,64 @@ void drawPipe()
         glColor4f(1, 1, 0, 0.3f);
     }
 
+    // cull the chunks and choose the levels with the current camera
+    float matrix[16];
+    glGetFloatv(GL_MODELVIEW_MATRIX, matrix);
+    Matrix4 view(matrix);
+    glGetFloatv(GL_PROJECTION_MATRIX, matrix);
+    Matrix4 projection(matrix);
+    updateChunks();
+    cullChunks(projection * view);
+    selectChunkLods(view);
+
     glLineWidth(1);
-    int count = pipe.getContourCount();
-    for(int i = 0; i < count; ++i)
+    if(chunks.empty() && pipeLod.getRingCount() > 0)
+        drawRing(pipeLod.getContour(0, 0), pipeLod.getNormal(0, 0));
+    for(int c = 0; c < (int)chunks.size(); ++c)
     {
-        std::vector<Vector3> contour = pipe.getContour(i);
-        std::vector<Vector3> normal = pipe.getNormal(i);
-        glBegin(GL_LINES);
-        for(int j = 0; j < (int)contour.size() - 1; ++j)
-        {
-            glNormal3fv(&normal[j].x);
-            glVertex3fv(&contour[j].x);
-            glNormal3fv(&normal[j+1].x);
-            glVertex3fv(&contour[j+1].x);
-        }
-        glEnd();
+        const PipeChunk& chunk = chunks[c];
+        if(!chunk.visible)
+            continue;
+
+        int last = chunk.first + chunk.count;
+        for(int i = chunk.first; i < last; i += (1 << chunk.step))
+            drawRing(pipeLod.getContour(chunk.level, i), pipeLod.getNormal(chunk.level, i));
+        if(c == (int)chunks.size() - 1)
+            drawRing(pipeLod.getContour(chunk.level, last), pipeLod.getNormal(chunk.level, last));
     }
 
     // surface
-    for(int i = 0; i < count - 1; ++i)
+    // build interleaved (normal, vertex) strip with the dispatched kernel
+    const KernelTable<float>& kernels = getKernels<float>();
+    drawnTriangles = 0;
+    for(int c = 0; c < (int)chunks.size(); ++c)
     {
-        std::vector<Vector3> c1 = pipe.getContour(i);
-        std::vector<Vector3> c2 = pipe.getContour(i+1);
-        std::vector<Vector3> n1 = pipe.getNormal(i);
-        std::vector<Vector3> n2 = pipe.getNormal(i+1);
-        glBegin(GL_TRIANGLE_STRIP);
-        for(int j = 0; j < (int)c2.size(); ++j)
+        const PipeChunk& chunk = chunks[c];
+        if(!chunk.visible)
+            continue;
+
+        int step = 1 << chunk.step;
+        int last = chunk.first + chunk.count;
+        for(int i = chunk.first; i < last; i += step)
         {
-            glNormal3fv(&n2[j].x);
-            glVertex3fv(&c2[j].x);
-            glNormal3fv(&n1[j].x);
-            glVertex3fv(&c1[j].x);
+            int next = (i + step < last) ? i + step : last;
+            const Pipe::Contour& c1 = pipeLod.getContour(chunk.level, i);
+            const Pipe::Contour& c2 = pipeLod.getContour(chunk.level, next);
+            const Pipe::Contour& n1 = pipeLod.getNormal(chunk.level, i);
+            const Pipe::Contour& n2 = pipeLod.getNormal(chunk.level, next);
+            int vertexCount = (int)c2.size();
+            if(vertexCount == 0)
+                continue;
+
+            stripVertices.resize(vertexCount * 12);
+            kernels.buildStrip(&c1[0], &n1[0], &c2[0], &n2[0], vertexCount, &stripVertices[0]);
+            glInterleavedArrays(GL_N3F_V3F, 0, &stripVertices[0]);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, vertexCount * 2);
+            drawnTriangles += (vertexCount - 1) * 2;
         }
-        glEnd();
     }
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
 
     /*
     glColor3f(1, 1, 0);
@@ -170,6 +245,214 @@ void drawPipe()
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// draw the outline of a ring
+///////////////////////////////////////////////////////////////////////////////
+void drawRing(const Pipe::Contour& contour, const Pipe::Contour& normal)
+{
+    glBegin(GL_LINES);
+    for(int j = 0; j < (int)contour.size() - 1; ++j)
+    {
+        glNormal3fv(&normal[j].x);
+        glVertex3fv(&contour[j].x);
+        glNormal3fv(&normal[j+1].x);
+        glVertex3fv(&contour[j+1].x);
+    }
+    glEnd();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// split the pipe into chunks of LOD_CHUNK_SIZE segments
+// The bounds and errors of a chunk are computed again only while its rings
+// can change; the last ring is recomputed when a point is added after it.
+///////////////////////////////////////////////////////////////////////////////
+void updateChunks()
+{
+    int segmentCount = pipeLod.getRingCount() - 1;
+
+    // the pipe is rewound
+    if(!chunks.empty() && chunks.back().first + chunks.back().count > segmentCount)
+        chunks.clear();
+
+    int chunkCount = (segmentCount > 0) ? (segmentCount + LOD_CHUNK_SIZE - 1) / LOD_CHUNK_SIZE : 0;
+    while((int)chunks.size() < chunkCount)
+    {
+        PipeChunk chunk;
+        chunk.first = (int)chunks.size() * LOD_CHUNK_SIZE;
+        chunk.count = 0;
+        chunk.level = 0;
+        chunk.step = 0;
+        chunk.visible = true;
+        chunks.push_back(chunk);
+    }
+
+    for(int c = 0; c < chunkCount; ++c)
+    {
+        PipeChunk& chunk = chunks[c];
+        int count = segmentCount - chunk.first;
+        if(count > LOD_CHUNK_SIZE)
+            count = LOD_CHUNK_SIZE;
+        if(count != chunk.count || chunk.first + count >= segmentCount - 1)
+        {
+            chunk.count = count;
+            computeChunk(chunk);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute the bounding sphere of the chunk and the errors of the ring steps
+// The error of a ring step is the largest distance from the vertices of the
+// skipped rings to the surface interpolated between the drawn rings, so it
+// grows with the curvature of the path. It is measured on the finest level.
+///////////////////////////////////////////////////////////////////////////////
+void computeChunk(PipeChunk& chunk)
+{
+    int last = chunk.first + chunk.count;
+
+    // sphere around the box of the vertices
+    Vector3 minPoint = pipeLod.getPipe().getPathPoint(chunk.first);
+    Vector3 maxPoint = minPoint;
+    for(int i = chunk.first; i <= last; ++i)
+    {
+        const Pipe::Contour& contour = pipeLod.getContour(0, i);
+        for(int j = 0; j < (int)contour.size(); ++j)
+        {
+            const Vector3& v = contour[j];
+            if(v.x < minPoint.x) minPoint.x = v.x;
+            if(v.y < minPoint.y) minPoint.y = v.y;
+            if(v.z < minPoint.z) minPoint.z = v.z;
+            if(v.x > maxPoint.x) maxPoint.x = v.x;
+            if(v.y > maxPoint.y) maxPoint.y = v.y;
+            if(v.z > maxPoint.z) maxPoint.z = v.z;
+        }
+    }
+    chunk.center = (minPoint + maxPoint) * 0.5f;
+    chunk.radius = (maxPoint - minPoint).length() * 0.5f;
+
+    for(int k = 0; k < LOD_STEP_COUNT; ++k)
+    {
+        int step = 1 << k;
+        float error = 0;
+        for(int a = chunk.first; a < last; a += step)
+        {
+            int b = (a + step < last) ? a + step : last;
+            const Pipe::Contour& ring1 = pipeLod.getContour(0, a);
+            const Pipe::Contour& ring2 = pipeLod.getContour(0, b);
+            for(int i = a + 1; i < b; ++i)
+            {
+                const Pipe::Contour& ring = pipeLod.getContour(0, i);
+                float t = (float)(i - a) / (b - a);
+                for(int j = 0; j < (int)ring.size(); ++j)
+                {
+                    float d = (ring[j] - (ring1[j] * (1 - t) + ring2[j] * t)).length();
+                    if(d > error)
+                        error = d;
+                }
+            }
+        }
+        chunk.stepErrors[k] = error;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// test the bounding spheres of the chunks against the view frustum at once
+// The matrix is (projection * modelview), so the planes are in the space of
+// the path points.
+///////////////////////////////////////////////////////////////////////////////
+void cullChunks(const Matrix4& matrix)
+{
+    int count = (int)chunks.size();
+    chunkX.resize(count);
+    chunkY.resize(count);
+    chunkZ.resize(count);
+    chunkRadii.resize(count);
+    chunkMask.resize(count);
+    for(int c = 0; c < count; ++c)
+    {
+        chunkX[c] = chunks[c].center.x;
+        chunkY[c] = chunks[c].center.y;
+        chunkZ[c] = chunks[c].center.z;
+        chunkRadii[c] = chunks[c].radius;
+    }
+
+    visibleChunks = count;
+    if(cullingEnabled && count > 0)
+    {
+        Plane planes[6];
+        Plane::getFrustumPlanes(matrix, planes);
+        visibleChunks = Plane::testSpheres(planes, 6, &chunkX[0], &chunkY[0], &chunkZ[0], &chunkRadii[0],
+                                           count, &chunkMask[0]);
+    }
+
+    for(int c = 0; c < count; ++c)
+        chunks[c].visible = !cullingEnabled || chunkMask[c];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// choose the level and the ring step of each chunk from the screen size of
+// the errors at the nearest point of its bounding sphere
+///////////////////////////////////////////////////////////////////////////////
+void selectChunkLods(const Matrix4& view)
+{
+    // pixels per unit length at the distance 1
+    const float DEG2RAD = acos(-1.0f) / 180;
+    float scale = screenHeight / (2 * tanf(CAMERA_FOV * 0.5f * DEG2RAD));
+
+    for(int c = 0; c < (int)chunks.size(); ++c)
+    {
+        PipeChunk& chunk = chunks[c];
+        if(!chunk.visible)
+            continue;
+
+        if(!lodEnabled)
+        {
+            chunk.level = chunk.step = 0;
+            continue;
+        }
+
+        float depth = -(view * chunk.center).z - chunk.radius;
+        if(depth < CAMERA_NEAR)
+            depth = CAMERA_NEAR;
+        float maxError = LOD_PIXEL_ERROR * depth / scale;
+        float minError = maxError * (1 - LOD_HYSTERESIS);
+
+        // level: finer right away if the current one is over the limit
+        if(pipeLod.getError(chunk.level) > maxError)
+        {
+            chunk.level = pipeLod.selectLevel(maxError);
+        }
+        else
+        {
+            int level = pipeLod.selectLevel(minError);
+            if(pipeLod.getVertexCount(level) < pipeLod.getVertexCount(chunk.level))
+                chunk.level = level;
+        }
+
+        // ring step: the largest step within the error
+        if(chunk.stepErrors[chunk.step] > maxError)
+        {
+            while(chunk.step > 0 && chunk.stepErrors[chunk.step] > maxError)
+                --chunk.step;
+        }
+        else
+        {
+            while(chunk.step < LOD_STEP_COUNT - 1 && chunk.stepErrors[chunk.step + 1] <= minError)
+                ++chunk.step;
+        }
+    }
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // draw lines along the path
 ///////////////////////////////////////////////////////////////////////////////
@@ -183,6 +466,7 @@ void drawPath()
     glLineWidth(2.0f);
     glBegin(GL_LINES);
 
+    const Pipe& pipe = pipeLod.getPipe();
     int count = pipe.getPathCount();
     for(int i = 0; i < count-1; ++i)
     {
@@ -282,6 +566,14 @@ void draw()
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
+    // "pipe --memory [rings]" prints the memory counters of a long sweep
+    // without opening a window
+    if(argc > 1 && std::string(argv[1]) == "--memory")
+    {
+        measureMemory(argc > 2 ? std::atoi(argv[2]) : 200000);
+        return 0;
+    }
+
     initSharedMem();
 
     // register exit callback
@@ -438,12 +730,18 @@ bool initSharedMem()
     std::cout << "fitst point: " << path[0] << std::endl;
     std::cout << "last point: " << path[path.size()-1] << std::endl;
 
+    std::cout << "kernel ISA: " << getKernels<float>().name << std::endl;
+
     // sectional contour of pipe
     circle = buildCircle(0.5f, CIRCLE_SECTORS); // radius, segments
 
-    // configure pipe
+    // configure pipe with all levels of detail, the first level is the circle
+    std::vector<Pipe::ProfilePtr> profiles;
+    profiles.push_back(ProfileRegistry::getInstance().getProfile(circle));
+    for(int i = 1; i < LOD_LEVEL_COUNT; ++i)
+        profiles.push_back(ProfileRegistry::getInstance().getProfile(buildCircle(0.5f, LOD_SECTORS[i])));
     std::vector<Vector3> p(1, path[0]);
-    pipe.set(p, circle);
+    pipeLod.set(p, profiles);
     currIndex = 0;
 
     return true;
@@ -538,6 +836,15 @@ std::vector<Vector3> buildCircle(float radius, int steps)
     std::vector<Vector3> points;
     if(steps < 2) return points;
 
+    // use the compile-time table if there is one for this sector count
+    const Vector3* unitCircle = getUnitCircle<float>(steps);
+    if(unitCircle)
+    {
+        for(int i = 0; i <= steps; ++i)
+            points.push_back(unitCircle[i] * radius);
+        return points;
+    }
+
     const float PI2 = acos(-1) * 2.0f;
     float x, y, a;
     for(int i = 0; i <= steps; ++i)
@@ -577,6 +884,22 @@ void showInfo()
     drawString(ss.str().c_str(), 1, 1, color, font);
     ss.str("");
 
+    ss << "Press L to toggle LOD: " << (lodEnabled ? "on" : "off") << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press C to toggle culling: " << (cullingEnabled ? "on" : "off") << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + FONT_HEIGHT * 2, color, font);
+    ss.str("");
+
+    ss << "Triangles: " << drawnTriangles << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight - FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Chunks: " << visibleChunks << " / " << chunks.size() << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight - FONT_HEIGHT * 2, color, font);
+    ss.str("");
+
     // unset floating format
     ss << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
 
@@ -605,12 +928,12 @@ void displayCB()
         ++currIndex;
         if(currIndex < path.size())
         {
-            pipe.addPathPoint(path[currIndex]);
+            pipeLod.addPathPoint(path[currIndex]);
         }
         else
         {
-            std::vector<Vector3> p(1, path[0]);
-            pipe.set(p, circle);
+            // rewind to the first point, reusing the first contours
+            pipeLod.getPipe().truncate(1);
             currIndex = 0;
         }
     }
@@ -646,7 +969,7 @@ void reshapeCB(int width, int height)
     // set perspective viewing frustum
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(60.0f, (float)(width)/height, 1.0f, 1000.0f); // FOV, AspectRatio, NearClip, FarClip
+    gluPerspective(CAMERA_FOV, (float)(width)/height, CAMERA_NEAR, CAMERA_FAR); // FOV, AspectRatio, NearClip, FarClip
 
     // switch to modelview matrix in order to set scene
     glMatrixMode(GL_MODELVIEW);
@@ -703,6 +1026,16 @@ void keyboardCB(unsigned char key, int x, int y)
         }
         break;
 
+    case 'l': // toggle levels of detail
+    case 'L':
+        lodEnabled = !lodEnabled;
+        break;
+
+    case 'c': // toggle frustum culling
+    case 'C':
+        cullingEnabled = !cullingEnabled;
+        break;
+
     default:
         ;
     }
@@ -771,3 +1104,45 @@ void exitCB()
 {
     clearSharedMem();
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sweep a long pipe into the heap and into arenas of mapped pages, and print
+// the page faults, the data TLB misses (-1 if not permitted) and the time of
+// each sweep
+///////////////////////////////////////////////////////////////////////////////
+void measureMemory(int ringCount)
+{
+    if(ringCount < 2)
+        ringCount = 2;
+    std::vector<Vector3> longPath = buildSpiralPath(4, 1, -3, 3, 3.5f * ringCount / 200, ringCount);
+    std::vector<Vector3> contour = buildCircle(0.5f, CIRCLE_SECTORS);
+    std::cout << "rings: " << ringCount << ", vertices per ring: " << contour.size()
+              << ", huge page: " << (PageResource::getHugePageSize() >> 10) << " KB" << std::endl;
+
+    const int COUNT = 4;
+    const char* names[COUNT] = { "heap", "arena, pages", "arena, huge pages", "arena, huge pages, populate" };
+    const int pageFlags[COUNT] = { PAGE_DEFAULT, PAGE_DEFAULT, PAGE_HUGE, PAGE_HUGE | PAGE_POPULATE };
+    for(int i = 0; i < COUNT; ++i)
+    {
+        PageResource pages(pageFlags[i]);
+        MonotonicArena arena(64 << 20, &pages);
+        Pipe pipe(i == 0 ? 0 : &arena);
+
+        MemoryCounters before, after;
+        Timer timer;
+        readMemoryCounters(before);
+        timer.start();
+        pipe.set(longPath, contour);
+        timer.stop();
+        readMemoryCounters(after);
+
+        long long tlbMisses = (before.tlbMisses >= 0 && after.tlbMisses >= 0) ? after.tlbMisses - before.tlbMisses : -1;
+        std::cout << std::left << std::setw(30) << names[i] << std::right
+                  << "minor faults: " << std::setw(8) << after.minorFaults - before.minorFaults
+                  << "  TLB misses: " << std::setw(10) << tlbMisses
+                  << "  time: " << std::fixed << std::setprecision(1) << timer.getElapsedTimeInMilliSec() << " ms"
+                  << std::endl;
+    }
+}